@@ -0,0 +1,98 @@
+/*
+ * Compares the Grid storage layouts per access pattern:
+ * row walks, column walks, a 4-neighbour stencil and a north tilt.
+ *
+ * ./build/aoc-bench [side]
+ */
+#include <chrono>
+#include <random>
+#include <string>
+#include "fmt/format.h"
+#include "../src/solutions/grid.h"
+#include "../src/solutions/layout_grid.h"
+#include "../src/solutions/tilt.h"
+
+template<typename Fn>
+static double best_of(int repeats, Fn fn) {
+    double best = 1e300;
+    for (int repeat = 0; repeat < repeats; ++repeat) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        std::chrono::duration<double, std::milli> took = std::chrono::steady_clock::now() - start;
+        best = std::min(best, took.count());
+    }
+    return best;
+}
+
+// Sum kept in a volatile, so the walks are not optimised away
+static volatile long sink = 0;
+
+template<typename CellGrid>
+static void run(const std::string& name, const Grid& source) {
+    const auto rows = (long)source.rows;
+    const auto columns = (long)source.columns;
+
+    auto row_walk = [&](const CellGrid& grid) {
+        long sum = 0;
+        for (long row = 0; row < rows; ++row) {
+            for (long column = 0; column < columns; ++column) sum += grid.at_unchecked({row, column});
+        }
+        sink = sum;
+    };
+    auto column_walk = [&](const CellGrid& grid) {
+        long sum = 0;
+        for (long column = 0; column < columns; ++column) {
+            for (long row = 0; row < rows; ++row) sum += grid.at_unchecked({row, column});
+        }
+        sink = sum;
+    };
+    auto stencil = [&](const CellGrid& grid) {
+        long sum = 0;
+        for (long row = 1; row < rows - 1; ++row) {
+            for (long column = 1; column < columns - 1; ++column) {
+                sum += grid.at_unchecked({row - 1, column}) + grid.at_unchecked({row + 1, column})
+                       + grid.at_unchecked({row, column - 1}) + grid.at_unchecked({row, column + 1});
+            }
+        }
+        sink = sum;
+    };
+
+    CellGrid grid = [&source]() {
+        if constexpr (std::is_same_v<CellGrid, Grid>) return source;
+        else return make_layout_grid<typename CellGrid::layout_type>(source);
+    }();
+
+    double rows_ms = best_of(5, [&]() { row_walk(grid); });
+    double columns_ms = best_of(5, [&]() { column_walk(grid); });
+    double stencil_ms = best_of(5, [&]() { stencil(grid); });
+    double tilt_ms = best_of(5, [&]() {
+        auto copy = grid;
+        tilt(copy, NEIGHBOURS_4[0]);
+        tilt(copy, NEIGHBOURS_4[2]);
+    });
+
+    fmt::println("{:<12} {:>10.2f} {:>10.2f} {:>10.2f} {:>10.2f}", name, rows_ms, columns_ms, stencil_ms, tilt_ms);
+}
+
+int main(int argc, char **argv) {
+    const std::size_t side = argc > 1 ? std::stoul(argv[1]) : 4096;
+
+    // Rolling-rock style content, 1/3 rocks and 1/10 walls
+    std::mt19937 random(2023);
+    std::string cells(side * side, '.');
+    for (auto &cell: cells) {
+        auto roll = random() % 30;
+        if (roll < 10) cell = 'O';
+        else if (roll < 13) cell = '#';
+    }
+    Grid source{side, side, cells};
+
+    fmt::println("{} x {} grid, best of 5 in ms", side, side);
+    fmt::println("{:<12} {:>10} {:>10} {:>10} {:>10}", "layout", "rows", "columns", "stencil", "tilt N+S");
+    run<Grid>("Grid", source);
+    run<LayoutGrid<RowMajorLayout>>("row-major", source);
+    run<LayoutGrid<TiledLayout>>("tiled 8x8", source);
+    run<LayoutGrid<MortonLayout>>("morton", source);
+
+    return 0;
+}
@@ -1,44 +1,44 @@
 #include "../one_solution.h"
-
-static auto pair_compare = [](std::pair<int, int> a, std::pair<int, int> b) {
-    return a.first < b.first || (!(b.first < a.first) && a.second < b.second);
-};
+#include "../sparse_grid.h"
+
+static void move(GridCell &position, char c) {
+    if (c == '^') {
+        position.row++;
+    } else if (c == 'v') {
+        position.row--;
+    } else if (c == '>') {
+        position.column++;
+    } else if (c == '<') {
+        position.column--;
+    }
+}
 
 SOLVER(2015, 3, 1, true)
 (const std::string &str) {
-    std::set<std::pair<int, int>, decltype(pair_compare)> visited(pair_compare);
+    SparseGrid visited;
 
-    std::pair<int, int> position = {0, 0};
-    visited.insert(position);
+    GridCell position = {0, 0};
+    visited.set(position, 'x');
 
     // std::string example = ">"; // 2
     // std::string example = "^>v<"; // 4
     // std::string example = "^v^v^v^v^v"; // 2
 
     for (auto c : str) {
-        if (c == '^') {
-            position.first++;
-        } else if (c == 'v') {
-            position.first--;
-        } else if (c == '>') {
-            position.second++;
-        } else if (c == '<') {
-            position.second--;
-        }
-
-        visited.insert(position);
+        move(position, c);
+        visited.set(position, 'x');
     }
 
-    return fmt::format("{}", visited.size());
+    return fmt::format("{}", visited.count('x'));
 }
 
 SOLVER(2015, 3, 2, true)
 (const std::string &str) {
-    std::set<std::pair<int, int>, decltype(pair_compare)> visited(pair_compare);
+    SparseGrid visited;
 
-    std::pair<int, int> first_position = {0, 0};
-    std::pair<int, int> second_position = {0, 0};
-    visited.insert(first_position);
+    GridCell first_position = {0, 0};
+    GridCell second_position = {0, 0};
+    visited.set(first_position, 'x');
     int idx = 0;
 
     // std::string example = "^v"; // 3
@@ -47,21 +47,11 @@ SOLVER(2015, 3, 2, true)
 
     for (auto c : str) {
         auto active_position = idx % 2 == 0 ? &first_position : &second_position;
+        move(*active_position, c);
 
-        if (c == '^') {
-            active_position->first++;
-        } else if (c == 'v') {
-            active_position->first--;
-        } else if (c == '>') {
-            active_position->second++;
-        } else if (c == '<') {
-            active_position->second--;
-        }
-
-        visited.insert(first_position);
-        visited.insert(second_position);
+        visited.set(*active_position, 'x');
         idx++;
     }
 
-    return fmt::format("{}", visited.size());
-}
\ No newline at end of file
+    return fmt::format("{}", visited.count('x'));
+}
@@ -1,6 +1,7 @@
 #include <regex>
 #include "../one_solution.h"
 #include "../grid.h"
+#include "../rect_updates.h"
 
 #pragma region Example Inputs
 constexpr const std::string_view EXAMPLE_INPUT_1 = R"(
@@ -49,40 +50,30 @@ static std::vector<Instruction> parse_instructions(const std::string &in) {
     return instructions;
 }
 
-SOLVER(2015, 6, 1, false)
-(const std::string &in) {
-//    auto instructions = parse_instructions(std::string(EXAMPLE_INPUT_1));
-    auto instructions = parse_instructions(in);
+static const std::map<InstructionType, RectOperation> instruction_type_to_rect_operation = {
+        {TURN_ON, RECT_SET},
+        {TURN_OFF, RECT_RESET},
+        {TOGGLE, RECT_TOGGLE},
+};
 
-    Grid grid = make_grid(1000, 1000, '.');
+static std::vector<RectUpdate> to_rect_updates(const std::vector<Instruction> &instructions) {
+    std::vector<RectUpdate> updates;
+    updates.reserve(instructions.size());
     for (const auto &instruction: instructions) {
-        if (grid.underlying_idx(instruction.from) > grid.underlying_idx(instruction.to)) {
+        if (instruction.to < instruction.from) {
             throw std::logic_error("Inverse direction not implemented");
         }
-
-        for (long column = instruction.from.column; column <= instruction.to.column; ++column) {
-            for (long row = instruction.from.row; row <= instruction.to.row; ++row) {
-                if (instruction.type == TURN_ON) {
-                    grid.set_value(GridCell{row, column}, '#');
-                } else if (instruction.type == TURN_OFF) {
-                    grid.set_value(GridCell{row, column}, '.');
-                } else if (instruction.type == TOGGLE) {
-                    if (grid.at(column, row) == '.') {
-                        grid.set_value(GridCell{row, column}, '#');
-                    } else {
-                        grid.set_value(GridCell{row, column}, '.');
-                    }
-                }
-            }
-        }
+        updates.push_back(RectUpdate{instruction_type_to_rect_operation.at(instruction.type), instruction.from, instruction.to});
     }
+    return updates;
+}
 
-    long counter = 0;
-    for (long column = 0; column < grid.columns; ++column) {
-        for (long row = 0; row < grid.rows; ++row) {
-            if (grid.at(column, row) == '#') counter++;
-        }
-    }
+SOLVER(2015, 6, 1, false)
+(const std::string &in) {
+//    auto instructions = parse_instructions(std::string(EXAMPLE_INPUT_1));
+    auto instructions = parse_instructions(in);
+
+    long counter = count_set_cells(to_rect_updates(instructions));
 
     // 568658 too low, forgot inclusivity
     return fmt::format("{}", counter);
@@ -94,36 +85,17 @@ SOLVER(2015, 6, 2, true)
 //    auto instructions = parse_instructions(std::string("turn on 0,0 through 0,0"));
     auto instructions = parse_instructions(in);
 
-    Grid grid = make_grid(1000, 1000, '\0');
-    for (const auto &instruction: instructions) {
-        if (grid.underlying_idx(instruction.from) > grid.underlying_idx(instruction.to)) {
-            throw std::logic_error("Inverse direction not implemented");
-        }
-
-        for (long column = instruction.from.column; column <= instruction.to.column; ++column) {
-            for (long row = instruction.from.row; row <= instruction.to.row; ++row) {
-                char current_value = grid.at(column, row);
-                if (current_value >= 120) {
-                    fmt::println("warning! value nearing limit");
-                }
-                if (instruction.type == TURN_ON) {
-                    grid.set_value(GridCell{row, column}, (char)(current_value + 1));
-                } else if (instruction.type == TURN_OFF) {
-                    if (current_value == 0) continue;
-                    grid.set_value(GridCell{row, column}, (char)(current_value - 1));
-                } else if (instruction.type == TOGGLE) {
-                    grid.set_value(GridCell{row, column}, (char)(current_value + 2));
-                }
-            }
-        }
-    }
-
-    long counter = 0;
-    for (long column = 0; column < grid.columns; ++column) {
-        for (long row = 0; row < grid.rows; ++row) {
-            counter += (char)grid.at(column, row);
+    long counter = sweep_rectangles<long>(to_rect_updates(instructions), [](long &brightness, const RectUpdate &update) {
+        if (update.operation == RECT_SET) {
+            brightness += 1;
+        } else if (update.operation == RECT_RESET) {
+            brightness = std::max(0l, brightness - 1);
+        } else if (update.operation == RECT_TOGGLE) {
+            brightness += 2;
         }
-    }
+    }, [](long brightness) {
+        return brightness;
+    });
 
     // 18800085 too high
     // 17325717 with negative values - too low
@@ -1,5 +1,6 @@
 #include "../one_solution.h"
 #include "../grid.h"
+#include "../cell_set.h"
 #include <map>
 
 constexpr const std::string_view EXAMPLE_INPUT_1 = R"(
@@ -27,7 +28,7 @@ static std::map<Direction, GridCell> direction_to_vector = {
 };
 
 static long count_visible_from_directions(const Grid &grid) {
-    std::set<GridCell> visible_trees;
+    CellSet visible_trees;
 
     for (long row = 0; row < grid.rows; ++row) {
         long right_max = std::numeric_limits<long>::min();
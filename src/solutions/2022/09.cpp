@@ -1,5 +1,6 @@
 #include "../one_solution.h"
 #include "../grid.h"
+#include "../cell_set.h"
 #include "../string_split.h"
 #include "../../trim.h"
 #include <map>
@@ -97,7 +98,7 @@ SOLVER(2022, 9, 1, true)
     auto instructions = parse_instructions(in);
 //    auto instructions = parse_instructions(std::string(EXAMPLE_INPUT_1));
 
-    std::set<GridCell> visited_cells;
+    CellSet visited_cells;
 
     GridCell head{0, 0};
     GridCell tail{0, 0};
@@ -118,7 +119,7 @@ SOLVER(2022, 9, 2, false)
 //    auto instructions = parse_instructions(in);
     auto instructions = parse_instructions(std::string(EXAMPLE_INPUT_2));
 
-    std::set<GridCell> visited_cells;
+    CellSet visited_cells;
 
     const int PARTS_COUNT = 10;
 
@@ -3,6 +3,7 @@
 #include <map>
 #include <queue>
 #include <numeric>
+#include "../cycle.h"
 
 #pragma region Example Inputs
 constexpr const std::string_view EXAMPLE_INPUT_1 = R"(
@@ -154,6 +155,103 @@ static void do_monkey_business(std::map<uint, Monkey>& monkeys, uint rounds, boo
     }
 }
 
+namespace {
+    typedef struct ItemState {
+        uint monkey;
+        long worry_level;
+
+        bool operator==(const ItemState& other) const = default;
+    } ItemState;
+}
+
+static long apply_operation(const Monkey &monkey, long worry_level) {
+    long operand = monkey.operand == OPERAND_OLD ? worry_level : monkey.operand;
+    switch (monkey.operation) {
+        case ADDITION:
+            return worry_level + operand;
+        case SUBTRACTION:
+            return worry_level - operand;
+        case MULTIPLICATION:
+            return worry_level * operand;
+    }
+    throw std::logic_error("Unknown operation");
+}
+
+/*
+ * Follows a single item through one round. Items never affect each other's worry level or target, so
+ * each one can be simulated on its own. Thrown to a monkey whose turn is still to come, the item is
+ * inspected again in the same round.
+ */
+static ItemState throw_item_for_a_round(
+        const std::map<uint, Monkey> &monkeys,
+        ItemState item,
+        long divisor_product,
+        std::vector<long> &inspections
+) {
+    while (true) {
+        const auto &monkey = monkeys.at(item.monkey);
+        inspections.at(item.monkey)++;
+        item.worry_level = apply_operation(monkey, item.worry_level) % divisor_product;
+
+        uint next_monkey = item.worry_level % monkey.divisibility_test == 0 ? monkey.if_true : monkey.if_false;
+        bool same_round = next_monkey > item.monkey;
+        item.monkey = next_monkey;
+        if (!same_round) return item;
+    }
+}
+
+/**
+ * Inspections per monkey after the rounds, without dividing the worry levels by 3. The worry levels are
+ * kept modulo the product of the divisors, so every item ends up in a loop: the rounds before it are
+ * simulated, one lap is counted and multiplied, and only what is left of the last lap is simulated again.
+ */
+static std::vector<long> count_inspections(const std::map<uint, Monkey> &monkeys, std::size_t rounds) {
+    long divisor_product = std::accumulate(monkeys.begin(), monkeys.end(), 1l, [](auto acc, auto const &id_and_monkey) {
+        return acc * id_and_monkey.second.divisibility_test;
+    });
+
+    std::vector<long> inspections(monkeys.size(), 0);
+    std::vector<long> ignored(monkeys.size(), 0);
+    auto round = [&monkeys, divisor_product, &ignored](const ItemState &item) {
+        return throw_item_for_a_round(monkeys, item, divisor_product, ignored);
+    };
+    auto key = [](const ItemState &item) {
+        return std::pair{item.monkey, item.worry_level};
+    };
+
+    for (const auto &[id, monkey]: monkeys) {
+        for (const auto &item: monkey.items) {
+            ItemState state{id, std::stol(BigInt(item).to_string()) % divisor_product};
+            auto cycle = find_cycle(state, round, key, rounds);
+            if (!cycle.has_value()) {
+                for (std::size_t i = 0; i < rounds; ++i) {
+                    state = throw_item_for_a_round(monkeys, state, divisor_product, inspections);
+                }
+                continue;
+            }
+
+            for (std::size_t i = 0; i < cycle->start; ++i) {
+                state = throw_item_for_a_round(monkeys, state, divisor_product, inspections);
+            }
+
+            std::vector<long> lap(monkeys.size(), 0);
+            for (std::size_t i = 0; i < cycle->length; ++i) {
+                state = throw_item_for_a_round(monkeys, state, divisor_product, lap);
+            }
+            long laps = (long)((rounds - cycle->start) / cycle->length);
+            for (std::size_t monkey_id = 0; monkey_id < lap.size(); ++monkey_id) {
+                inspections[monkey_id] += lap[monkey_id] * laps;
+            }
+
+            for (std::size_t i = 0; i < (rounds - cycle->start) % cycle->length; ++i) {
+                state = throw_item_for_a_round(monkeys, state, divisor_product, inspections);
+            }
+        }
+    }
+
+    return inspections;
+}
+
 SOLVER(2022, 11, 1, true)
 (const std::string &in) {
 //    auto monkeys = parse_monkeys(std::string(EXAMPLE_INPUT_1));
@@ -176,12 +274,7 @@ SOLVER(2022, 11, 2, true)
 //        auto monkeys = parse_monkeys(std::string(EXAMPLE_INPUT_1));
     auto monkeys = parse_monkeys(in);
 
-    do_monkey_business(monkeys, 10'000, false);
-
-    std::vector<long> inspections(monkeys.size());
-    std::transform(monkeys.begin(), monkeys.end(), inspections.begin(), [](auto const &id_and_monkey) {
-        return id_and_monkey.second.inspections;
-    });
+    auto inspections = count_inspections(monkeys, 10'000);
     std::sort(inspections.begin(), inspections.end(), std::greater());
     long product = inspections.at(0) * inspections.at(1);
 
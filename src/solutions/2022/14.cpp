@@ -1,4 +1,7 @@
 #include "../one_solution.h"
+#include "../sparse_grid.h"
+#include "../string_split.h"
+#include "../../trim.h"
 
 #pragma region Example Inputs
 constexpr const std::string_view EXAMPLE_INPUT_1 = R"(
@@ -7,12 +10,94 @@ constexpr const std::string_view EXAMPLE_INPUT_1 = R"(
 )";
 #pragma endregion
 
-SOLVER(2022, 14, 1, false)
+static const GridCell SAND_SOURCE = {0, 500};
+
+/**
+ * Draws the rock paths, x is the column and y the row
+ *
+ * @return the lowest row holding rock
+ */
+static long parse_rocks(const std::string &in, SparseGrid &cave) {
+    long lowest_row = 0;
+    for (const auto &path_str: string_split(trim(in), '\n')) {
+        std::vector<GridCell> points;
+        for (const auto &point_str: string_split(path_str, ' ')) {
+            if (point_str == "->") continue;
+            auto coordinates = string_split(point_str, ',');
+            points.push_back(GridCell{std::stol(coordinates.at(1)), std::stol(coordinates.at(0))});
+        }
+
+        for (std::size_t i = 1; i < points.size(); ++i) {
+            auto from = points[i - 1];
+            auto to = points[i];
+            GridCell step{(to.row > from.row) - (to.row < from.row), (to.column > from.column) - (to.column < from.column)};
+            for (auto cell = from; cell != to; cell += step) {
+                cave.set(cell, '#');
+            }
+            cave.set(to, '#');
+            lowest_row = std::max({lowest_row, from.row, to.row});
+        }
+    }
+    return lowest_row;
+}
+
+/**
+ * Pours sand until a unit falls below abyss_row, or until the source is covered when there is a floor.
+ * The path of the previous unit is kept, the next one starts falling from where that one came to rest.
+ *
+ * @param floor_row row of the infinite floor, or none to let the sand fall into the abyss
+ * @return units of sand at rest
+ */
+static std::size_t pour_sand(SparseGrid &cave, long abyss_row, std::optional<long> floor_row) {
+    const std::array<GridCell, 3> falls = {GridCell{1, 0}, GridCell{1, -1}, GridCell{1, 1}};
+
+    std::size_t at_rest = 0;
+    std::vector<GridCell> path = {SAND_SOURCE};
+    while (!path.empty()) {
+        auto sand = path.back();
+        if (!floor_row.has_value() && sand.row > abyss_row) break;
+
+        bool moved = false;
+        for (const auto &fall: falls) {
+            auto next = sand + fall;
+            if (floor_row.has_value() && next.row == floor_row.value()) break;
+            if (cave.at(next) == '.') {
+                path.push_back(next);
+                moved = true;
+                break;
+            }
+        }
+
+        if (!moved) {
+            cave.set(sand, 'o');
+            at_rest++;
+            path.pop_back();
+        }
+    }
+
+    return at_rest;
+}
+
+SOLVER(2022, 14, 1, true)
 (const std::string &in) {
-    return fmt::format("{}", "n/a");
+//    auto input = std::string(EXAMPLE_INPUT_1);
+    auto input = in;
+
+    SparseGrid cave;
+    auto lowest_row = parse_rocks(input, cave);
+    auto at_rest = pour_sand(cave, lowest_row, std::nullopt);
+
+    return fmt::format("{}", at_rest);
 }
 
-SOLVER(2022, 14, 2, false)
+SOLVER(2022, 14, 2, true)
 (const std::string &in) {
-    return fmt::format("{}", "n/a");
+//    auto input = std::string(EXAMPLE_INPUT_1);
+    auto input = in;
+
+    SparseGrid cave;
+    auto lowest_row = parse_rocks(input, cave);
+    auto at_rest = pour_sand(cave, lowest_row, lowest_row + 2);
+
+    return fmt::format("{}", at_rest);
 }
@@ -27,27 +27,20 @@ typedef struct Symbol {
     std::set<NumberSpanningCells, decltype(cmp)> adjacent_numbers;
 } Symbol;
 
+// The grid must have a non-digit sentinel border, the cell may lie on it
 std::optional<NumberSpanningCells> find_number_spanning_cells(const Grid& grid, const GridCell& cell) {
-    if (std::isdigit(grid.at(cell.column, cell.row))) {
-        std::size_t starting_col = cell.column;
-        std::size_t ending_col = cell.column;
+    if (std::isdigit(grid.at_unchecked(cell))) {
+        long starting_col = cell.column;
+        long ending_col = cell.column;
 
         // Find start
-        while (true) {
-            if (std::isdigit(grid.at(starting_col - 1, cell.row))) {
-                starting_col--;
-            } else {
-                break;
-            }
+        while (std::isdigit(grid.at_unchecked({cell.row, starting_col - 1}))) {
+            starting_col--;
         }
 
         // Find end
-        while (true) {
-            if (std::isdigit(grid.at(ending_col + 1, cell.row))) {
-                ending_col++;
-            } else {
-                break;
-            }
+        while (std::isdigit(grid.at_unchecked({cell.row, ending_col + 1}))) {
+            ending_col++;
         }
 
         auto length = ending_col - starting_col + 1;
@@ -85,6 +78,8 @@ std::set<NumberSpanningCells, decltype(cmp)> scan_for_numbers_around(const Grid&
 
 std::vector<Symbol> find_symbols(const std::string &in) {
     Grid grid = make_grid(in);
+    // Neighbours of symbols on the edge are then just empty space
+    grid.set_sentinel_border('.');
 
     std::vector<Symbol> symbols;
 
@@ -5,6 +5,7 @@
 #include "../../trim.h"
 #include "../string_split.h"
 #include "../grid.h"
+#include "../summed_area.h"
 
 constexpr const std::string_view BEFORE_EXPANSION = R"(
 ...#......
@@ -39,39 +40,27 @@ struct expand_universe_return {
 };
 
 expand_universe_return expand_universe(const std::string &in) {
-    auto lines = string_split(trim(in), '\n');
-    const std::size_t column_count = lines.at(0).length();
-    const std::size_t row_count = lines.size();
+    auto grid = make_grid(in);
+    auto galaxy_counts = make_summed_area_table(grid, '#');
+    const auto column_count = (long)grid.columns;
+    const auto row_count = (long)grid.rows;
 
     std::set<uint> columns_to_expand;
     std::set<uint> rows_to_expand;
 
-    for (std::size_t column = 0; column < column_count; column++) {
-        bool should_expand = true;
-        for (std::size_t row = 0; row < row_count; row++) {
-            if (lines[row][column] == '#') {
-                should_expand = false;
-                break;
-            }
-        }
-
-        if (should_expand) {
+    for (long column = 0; column < column_count; column++) {
+        if (galaxy_counts.column_span(column, 0, row_count - 1) == 0) {
             columns_to_expand.insert(column);
         }
     }
 
-     for (std::size_t row_idx = 0; row_idx < row_count; row_idx++) {
-         auto row = lines[row_idx];
-         auto no_galaxies = std::all_of(row.begin(), row.end(), [](const char& c) {
-             return c == '.';
-         });
-
-         if (no_galaxies) {
-             rows_to_expand.insert(row_idx);
-         }
-     }
+    for (long row = 0; row < row_count; row++) {
+        if (galaxy_counts.row_span(row, 0, column_count - 1) == 0) {
+            rows_to_expand.insert(row);
+        }
+    }
 
-     return {columns_to_expand, rows_to_expand};
+    return {columns_to_expand, rows_to_expand};
 }
 
 std::set<GridCell> find_galaxies(const Grid &galaxy, const struct expand_universe_return &expansion, uint expansion_modifier = 1) {
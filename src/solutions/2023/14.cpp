@@ -1,5 +1,7 @@
 #include "../one_solution.h"
 #include "../grid.h"
+#include "../cycle.h"
+#include "../tilt.h"
 #include <map>
 
 constexpr const std::string_view EXAMPLE_INPUT_1 = R"(
@@ -16,6 +18,7 @@ O.#..O.#.#
 )";
 
 namespace {
+    // Same order as NEIGHBOURS_4
     typedef enum WalkDirection {
         NORTH = 0,
         EAST,
@@ -24,78 +27,17 @@ namespace {
     } WalkDirection;
 }
 
+// Rotations bringing the side the boulders roll towards to the top, a clockwise turn moves the west side up
 static const std::map<WalkDirection, int> direction_to_cw_rotations = {
         {NORTH, 0},
-        {EAST,  1},
+        {EAST,  3},
         {SOUTH, 2},
-        {WEST,  3},
+        {WEST,  1},
 };
 
-static std::map<std::pair<std::string, WalkDirection>, std::string> walk_boulders_cache{};
-static bool used_cache = false;
-
 static Grid walk_boulders(const Grid& in_grid, const WalkDirection& direction) {
-    auto cache_key = std::pair<std::string, WalkDirection>{in_grid.data, direction};
-    if (walk_boulders_cache.contains(cache_key)) {
-        used_cache = true;
-        return Grid{
-            in_grid.rows,
-            in_grid.columns,
-            walk_boulders_cache.at(cache_key),
-        };
-    }
-    used_cache = false;
-
     auto grid = in_grid; // Copy the grid
-
-    // 1. Rotate the grid to point north, since I am lazy to actually solve properly for other directions
-    auto cw_rotations = direction_to_cw_rotations.at(direction);
-    for (int rotation = 0; rotation < cw_rotations; rotation++) {
-        grid.rotate_cw();
-    }
-
-    // 2. Find the boulders in order
-    for (int row_idx = 0; row_idx < grid.rows; row_idx++) {
-        for (int column_idx = 0; column_idx < grid.columns; column_idx++) {
-            if (grid.at(column_idx, row_idx) == 'O') {
-                // Walk the boulder to the edge
-                int boulder_idx = row_idx - 1;
-                int to_move_to = row_idx;
-                for (; 0 <= boulder_idx; --boulder_idx) {
-                    auto next_cell = GridCell{(uint)boulder_idx, (uint)column_idx};
-                    auto next_cell_value = grid.at(next_cell);
-
-                    if (
-                            next_cell_value == '\0' || // cannot move beyond grid
-                            next_cell_value == 'O' || // cannot move beyond another boulder
-                            next_cell_value == '#' // cannot move beyond square boulder
-                    ) {
-                        break;
-                    } else if (next_cell_value == '.') {
-                        to_move_to--;
-                        continue;
-                    } else {
-                        throw std::logic_error("The next cell must have a valid value");
-                    }
-                }
-
-                // set initial position as space
-                grid.set_value({(uint)row_idx, (uint)column_idx}, '.');
-                // set destination position as the boulder ("move" it)
-                // if the destination is the same as the initial one, it just doesn't move
-                grid.set_value({(uint)to_move_to, (uint)column_idx}, 'O');
-            }
-        }
-    }
-
-    // 3. Rotate the grid back to point in whatever direction we initially wanted
-    auto back_cw_rotations = (4 - cw_rotations) % 4;
-    for (int rotation = 0; rotation < back_cw_rotations; rotation++) {
-        grid.rotate_cw();
-    }
-
-    walk_boulders_cache.insert({cache_key, grid.data});
-
+    tilt(grid, NEIGHBOURS_4[direction]);
     return grid;
 }
 
@@ -141,32 +83,28 @@ SOLVER(2023, 14, 1, true)
     return fmt::format("{}", load);
 }
 
-SOLVER(2023, 14, 2, false)
+SOLVER(2023, 14, 2, true)
 (const std::string &in) {
-//    auto grid = make_grid(in);
-    auto grid = make_grid(std::string(EXAMPLE_INPUT_1));
+    auto grid = make_grid(in);
+//    auto grid = make_grid(std::string(EXAMPLE_INPUT_1));
+    grid.enable_hashing();
 
     constexpr const ulong CYCLES = 1'000'000'000;
     const std::vector<WalkDirection> directions = {NORTH, WEST, SOUTH, EAST};
 
-    Grid walked_boulders = grid;
-    uint current_cycle = 0;
-
-    std::thread progress_thread = std::thread([&current_cycle, CYCLES]() {
-        while (current_cycle < CYCLES) {
-            auto percentage = ((double)current_cycle / (double)CYCLES) * 100;
-            fmt::println("At cycle {} of {}, done {:.2f}%", current_cycle, CYCLES, percentage);
-            std::this_thread::sleep_for(std::chrono::seconds (1));
-        }
-    });
-
-    for (; current_cycle < CYCLES; current_cycle++) {
+    // The boulders settle into a loop long before the last cycle, so skip straight to its equivalent
+    auto spin_cycle = [&directions](const Grid& state) {
+        Grid walked_boulders = state;
         for (const auto& direction: directions) {
             walked_boulders = walk_boulders(walked_boulders, direction);
-            if (!used_cache) fmt::println("cycle {} has not used cache", current_cycle);
         }
-    }
-    progress_thread.join();
+        return walked_boulders;
+    };
+    auto walked_boulders = fast_forward(grid, spin_cycle, [](const Grid& state) {
+        return state.state_hash();
+    }, CYCLES, [](const Grid& a, const Grid& b) {
+        return a.same_cells(b);
+    });
 
     auto load = compute_load_on_direction(walked_boulders, NORTH);
 
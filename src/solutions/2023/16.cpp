@@ -1,5 +1,6 @@
 #include "../one_solution.h"
 #include "../grid.h"
+#include "../cell_set.h"
 #include "../../trim.h"
 
 constexpr const std::string_view EXAMPLE_INPUT_1 = R"(
@@ -202,7 +203,7 @@ static long determine_energy(const Grid &grid, const Direction &from, const Grid
         }
     }
 
-    std::set<GridCell> energized_cells;
+    CellSet energized_cells;
     for (const auto &[_, visited]: visited_positions) {
         energized_cells.insert(visited);
     }
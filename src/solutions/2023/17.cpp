@@ -1,6 +1,7 @@
 #include "../one_solution.h"
 
-#include "../Graph.h"
+#include "../grid.h"
+#include "../implicit_search.h"
 
 constexpr const std::string_view EXAMPLE_INPUT_1 = R"(
 2413432311323
@@ -26,12 +27,70 @@ constexpr const std::string_view CRAFTED_EXAMPLE = R"(
 111111
 )";
 
-SOLVER(2023, 17, 1, false)
+namespace {
+    typedef struct Crucible {
+        GridCell cell;
+        // Index into NEIGHBOURS_4
+        int direction;
+        // Blocks moved in the current direction so far
+        int run;
+    } Crucible;
+}
+
+/**
+ * Least heat loss from the top-left to the bottom-right block, over states of (cell, direction, run).
+ * The crucible has to go at least min_run blocks before turning or stopping, and at most max_run straight.
+ */
+static long least_heat_loss(const Grid &grid, int min_run, int max_run) {
+    const GridCell goal{(long)grid.rows - 1, (long)grid.columns - 1};
+    const auto runs = (uint64_t)max_run + 1;
+
+    auto key = [&grid, runs](const Crucible &crucible) {
+        return ((uint64_t)grid.underlying_idx(crucible.cell) * 4 + crucible.direction) * runs + crucible.run;
+    };
+
+    auto successors = [&grid, min_run, max_run](const Crucible &crucible, auto emit) {
+        auto move = [&](int direction, int run) {
+            auto next = crucible.cell + NEIGHBOURS_4[direction];
+            if (!grid.contains(next)) return;
+            emit(Crucible{next, direction, run}, grid.at_unchecked(next) - '0');
+        };
+
+        if (crucible.run < max_run) move(crucible.direction, crucible.run + 1);
+        if (crucible.run >= min_run) {
+            move((crucible.direction + 1) % 4, 1);
+            move((crucible.direction + 3) % 4, 1);
+        }
+    };
+
+    auto is_goal = [&goal, min_run](const Crucible &crucible) {
+        return crucible.cell == goal && crucible.run >= min_run;
+    };
+
+    // Every block loses at least 1 heat, so the distance left is a lower bound
+    auto heuristic = [&goal](const Crucible &crucible) {
+        return (goal.row - crucible.cell.row) + (goal.column - crucible.cell.column);
+    };
+
+    // Starting with a run of 0 east or south lets the first move go either way
+    std::vector<Crucible> starts = {Crucible{{0, 0}, 1, 0}, Crucible{{0, 0}, 2, 0}};
+    auto result = implicit_search(starts, grid.rows * grid.columns * 4 * runs, key, successors, is_goal, heuristic);
+    if (!result.has_value()) throw std::logic_error("The crucible cannot reach the factory");
+    return result->cost;
+}
+
+SOLVER(2023, 17, 1, true)
 (const std::string &in) {
-    return "n/a";
+    auto grid = make_grid(in);
+//    auto grid = make_grid(std::string(EXAMPLE_INPUT_1));
+
+    return fmt::format("{}", least_heat_loss(grid, 1, 3));
 }
 
-SOLVER(2023, 17, 2, false)
+SOLVER(2023, 17, 2, true)
 (const std::string &in) {
-    return "n/a";
+    auto grid = make_grid(in);
+//    auto grid = make_grid(std::string(CRAFTED_EXAMPLE));
+
+    return fmt::format("{}", least_heat_loss(grid, 4, 10));
 }
@@ -1,8 +1,6 @@
 #include "Graph.h"
 
 #include <stdexcept>
-#include <limits>
-#include <queue>
 
 bool Edge::operator>(const Edge &other) const {
     return this->weight > other.weight;
@@ -15,6 +13,9 @@ void Graph::add_directed_edge(long source, long weight, long destination) {
         throw std::logic_error("loops unsupported for now");
     }
     this->edges[source].push_back(Edge{weight, destination});
+    min_weight = edge_total == 0 ? weight : std::min(min_weight, weight);
+    max_weight = edge_total == 0 ? weight : std::max(max_weight, weight);
+    edge_total++;
 }
 
 void Graph::add_undirected_edge(long source, long weight, long destination) {
@@ -24,68 +25,88 @@ void Graph::add_undirected_edge(long source, long weight, long destination) {
 
 std::vector<long> Graph::dijkstra(long start) {
     if (start >= this->node_count) throw std::logic_error("Cannot start outside of graph");
+    return dijkstra_distances(*this, start);
+}
 
-    std::vector<long> distances(this->node_count, std::numeric_limits<long>::max());
-    distances[start] = 0;
+std::vector<long> Graph::dijkstra_with_path(long source, long target) {
+    return dijkstra_path(*this, source, target);
+}
 
-    std::priority_queue<std::pair<long, long>, std::vector<std::pair<long, long>>, std::greater<>> priority_queue;
-    priority_queue.emplace(0l, start);
+std::vector<Edge> Graph::get_edges(long node) const {
+    return std::vector<Edge>{edges.at(node)};
+}
 
-    while (!priority_queue.empty()) {
-        long current_distance = priority_queue.top().first;
-        long source = priority_queue.top().second;
-        priority_queue.pop();
+SearchWorkspace::SearchWorkspace(std::size_t node_count):
+    forward{std::vector<uint32_t>(node_count, 0), std::vector<long>(node_count), std::vector<long>(node_count)},
+    backward{std::vector<uint32_t>(node_count, 0), std::vector<long>(node_count), std::vector<long>(node_count)} {}
 
-        if (current_distance > distances[source]) continue;
+uint32_t SearchWorkspace::begin() {
+    forward_heap.clear();
+    backward_heap.clear();
 
-        for (auto& [weight, destination]: this->edges[source]) {
-            if (distances[source] + weight < distances[destination]) {
-                distances[destination] = distances[source] + weight;
-                priority_queue.emplace(distances[destination], destination);
-            }
-        }
+    // Once in 2^32 searches the stamps would repeat, clear them for real then
+    if (++generation == 0) {
+        std::fill(forward.stamps.begin(), forward.stamps.end(), 0);
+        std::fill(backward.stamps.begin(), backward.stamps.end(), 0);
+        generation = 1;
     }
-
-    return distances;
+    return generation;
 }
 
-std::vector<long> Graph::dijkstra_with_path(long source, long target) {
-    std::vector<long> distances;
-    std::vector<long> parents;
-
-    distances.assign(this->node_count, std::numeric_limits<long>::max());
-    parents.assign(this->node_count, -1); // Initialize all parents to -1
+Graph Graph::reversed() const {
+    Graph reversed_graph(node_count);
+    for (long source = 0; source < node_count; ++source) {
+        for (const auto &edge: edges[source]) {
+            reversed_graph.add_directed_edge(edge.destination, edge.weight, source);
+        }
+    }
+    return reversed_graph;
+}
 
-    std::priority_queue<std::pair<long, long>, std::vector<std::pair<long, long>>, std::greater<>> pq;
-    pq.emplace(0, source);
-    distances[source] = 0;
+CsrGraph::CsrGraph(const Graph &graph) {
+    constexpr auto LIMIT = (long)std::numeric_limits<uint32_t>::max();
+    if (graph.size() >= LIMIT) throw std::logic_error("Too many nodes for 32-bit ids");
+
+    offsets.reserve(graph.size() + 1);
+    offsets.push_back(0);
+    for (long node = 0; node < graph.size(); ++node) {
+        for (const auto &edge: graph.edges_of(node)) {
+            if (edge.weight < 0 || edge.weight > LIMIT) throw std::logic_error("Edge weight does not fit into 32 bits");
+            min_weight = packed_edges.empty() ? edge.weight : std::min(min_weight, edge.weight);
+            max_weight = packed_edges.empty() ? edge.weight : std::max(max_weight, edge.weight);
+            packed_edges.push_back(CsrEdge{(uint32_t)edge.weight, (uint32_t)edge.destination});
+        }
+        if (packed_edges.size() >= LIMIT) throw std::logic_error("Too many edges for 32-bit offsets");
+        offsets.push_back((uint32_t)packed_edges.size());
+    }
+}
 
-    while (!pq.empty()) {
-        long dist = pq.top().first;
-        long u = pq.top().second;
-        pq.pop();
+std::vector<long> CsrGraph::dijkstra(long start) const {
+    if (start >= size()) throw std::logic_error("Cannot start outside of graph");
+    return dijkstra_distances(*this, start);
+}
 
-        if (dist > distances[u]) continue; // Skip if we've found a shorter path
+std::vector<long> CsrGraph::dijkstra_with_path(long source, long target) const {
+    return dijkstra_path(*this, source, target);
+}
 
-        for (auto& edge : this->edges[u]) {
-            long v = edge.destination;
+CsrGraph CsrGraph::reversed() const {
+    CsrGraph reversed_graph = *this;
+    reversed_graph.offsets.assign(offsets.size(), 0);
 
-            if (distances[u] + edge.weight < distances[v]) {
-                distances[v] = distances[u] + edge.weight;
-                parents[v] = u;
-                pq.emplace(distances[v], v);
-            }
-        }
+    // Counting sort of the edges by destination
+    for (const auto &edge: packed_edges) {
+        reversed_graph.offsets[edge.destination + 1]++;
     }
-
-    std::vector<long> path;
-    for (long v = target; v != -1; v = parents[v]) {
-        path.push_back(v);
+    for (std::size_t node = 1; node < offsets.size(); ++node) {
+        reversed_graph.offsets[node] += reversed_graph.offsets[node - 1];
     }
-    reverse(path.begin(), path.end());
-    return path;
-}
 
-std::vector<Edge> Graph::get_edges(long node) const {
-    return std::vector<Edge>{edges.at(node)};
+    std::vector<uint32_t> next(reversed_graph.offsets.begin(), reversed_graph.offsets.end() - 1);
+    for (long source = 0; source < size(); ++source) {
+        for (const auto &edge: edges_of(source)) {
+            reversed_graph.packed_edges[next[edge.destination]++] = CsrEdge{edge.weight, (uint32_t)source};
+        }
+    }
+    return reversed_graph;
 }
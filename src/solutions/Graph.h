@@ -1,6 +1,12 @@
 #ifndef AOC_GRAPH_H
 #define AOC_GRAPH_H
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <span>
 #include <vector>
 
 typedef struct Edge {
@@ -10,9 +16,16 @@ typedef struct Edge {
     bool operator>(const Edge &other) const;
 } Edge;
 
+// Searches switch from a binary heap to Dial's buckets when no edge weighs more than this
+inline constexpr long DIAL_MAX_WEIGHT = 256;
+
 class Graph {
     std::size_t node_count;
     std::vector<std::vector<Edge>> edges;
+    std::size_t edge_total = 0;
+    // Range of the edge weights, both 0 while there are no edges
+    long min_weight = 0;
+    long max_weight = 0;
 
 public:
     explicit Graph(std::size_t node_count): node_count(node_count), edges(node_count) {}
@@ -24,6 +37,462 @@ public:
     std::vector<long> dijkstra_with_path(long source, long target);
 
     [[nodiscard]] std::vector<Edge> get_edges(long node) const;
+
+    [[nodiscard]] std::size_t size() const { return node_count; }
+    [[nodiscard]] std::size_t edge_count() const { return edge_total; }
+
+    /**
+     * Edges leaving the node, without copying them
+     */
+    [[nodiscard]] std::span<const Edge> edges_of(long node) const { return edges[node]; }
+
+    [[nodiscard]] long min_edge_weight() const { return min_weight; }
+    [[nodiscard]] long max_edge_weight() const { return max_weight; }
+
+    /**
+     * @return the same graph with every edge pointing the other way
+     */
+    [[nodiscard]] Graph reversed() const;
+};
+
+typedef struct CsrEdge {
+    uint32_t weight;
+    uint32_t destination;
+} CsrEdge;
+
+/*
+ * Compressed sparse row graph - the edges of node n are packed_edges[offsets[n]..offsets[n + 1]).
+ * All edges sit in one array with 32-bit ids and weights, so a search walks memory in order
+ * instead of hopping between a heap block per node. Immutable once built.
+ */
+class CsrGraph {
+    std::vector<uint32_t> offsets;
+    std::vector<CsrEdge> packed_edges;
+    long min_weight = 0;
+    long max_weight = 0;
+
+public:
+    /**
+     * @throws std::logic_error if the graph has negative weights, or ids or weights over 32 bits
+     */
+    explicit CsrGraph(const Graph& graph);
+
+    std::vector<long> dijkstra(long start) const;
+    std::vector<long> dijkstra_with_path(long source, long target) const;
+
+    [[nodiscard]] std::size_t size() const { return offsets.size() - 1; }
+    [[nodiscard]] std::size_t edge_count() const { return packed_edges.size(); }
+
+    [[nodiscard]] std::span<const CsrEdge> edges_of(long node) const {
+        return {packed_edges.data() + offsets[node], packed_edges.data() + offsets[node + 1]};
+    }
+
+    [[nodiscard]] long min_edge_weight() const { return min_weight; }
+    [[nodiscard]] long max_edge_weight() const { return max_weight; }
+
+    [[nodiscard]] CsrGraph reversed() const;
+};
+
+/*
+ * Result of a shortest path search from one or more sources
+ */
+typedef struct ShortestPaths {
+    // Distance from the nearest source, max long if unreachable
+    std::vector<long> distances;
+    // Previous node on the shortest path, -1 for the sources and unreachable nodes
+    std::vector<long> parents;
+    // Source the node is nearest to, -1 if unreachable
+    std::vector<long> nearest_sources;
+} ShortestPaths;
+
+inline ShortestPaths start_search(std::size_t node_count, const std::vector<long>& sources) {
+    ShortestPaths paths{
+            std::vector<long>(node_count, std::numeric_limits<long>::max()),
+            std::vector<long>(node_count, -1),
+            std::vector<long>(node_count, -1),
+    };
+    for (auto source: sources) {
+        paths.distances[source] = 0;
+        paths.nearest_sources[source] = source;
+    }
+    return paths;
+}
+
+/**
+ * Dijkstra with a binary heap and lazy deletion, over any graph with size() and edges_of(node).
+ * All the sources start at distance zero.
+ */
+template<typename AnyGraph>
+ShortestPaths heap_search(const AnyGraph& graph, const std::vector<long>& sources) {
+    auto paths = start_search(graph.size(), sources);
+
+    std::priority_queue<std::pair<long, long>, std::vector<std::pair<long, long>>, std::greater<>> priority_queue;
+    for (auto source: sources) {
+        priority_queue.emplace(0l, source);
+    }
+
+    while (!priority_queue.empty()) {
+        auto [current_distance, source] = priority_queue.top();
+        priority_queue.pop();
+
+        if (current_distance > paths.distances[source]) continue;
+
+        for (const auto& edge: graph.edges_of(source)) {
+            const long destination = edge.destination;
+            if (current_distance + (long)edge.weight < paths.distances[destination]) {
+                paths.distances[destination] = current_distance + (long)edge.weight;
+                paths.parents[destination] = source;
+                paths.nearest_sources[destination] = paths.nearest_sources[source];
+                priority_queue.emplace(paths.distances[destination], destination);
+            }
+        }
+    }
+
+    return paths;
+}
+
+/**
+ * Dial's algorithm - a ring of max_weight + 1 buckets indexed by distance replaces the heap.
+ * Every pending node is at most max_weight away from the current distance, so the ring never
+ * wraps onto itself, and pushing or popping a node is O(1). Weights must be non-negative.
+ *
+ * Same distances as heap_search, equally short parents may differ on ties.
+ */
+template<typename AnyGraph>
+ShortestPaths dial_search(const AnyGraph& graph, const std::vector<long>& sources, long max_weight) {
+    auto paths = start_search(graph.size(), sources);
+
+    const auto bucket_count = (std::size_t)max_weight + 1;
+    std::vector<std::vector<long>> buckets(bucket_count);
+    buckets[0] = sources;
+    std::size_t pending = sources.size();
+
+    for (long distance = 0; pending > 0; ++distance) {
+        auto& bucket = buckets[distance % bucket_count];
+        // Zero weight edges push back onto the bucket being drained
+        while (!bucket.empty()) {
+            long source = bucket.back();
+            bucket.pop_back();
+            pending--;
+            if (paths.distances[source] != distance) continue;
+
+            for (const auto& edge: graph.edges_of(source)) {
+                const long destination = edge.destination;
+                const long candidate = distance + (long)edge.weight;
+                if (candidate < paths.distances[destination]) {
+                    paths.distances[destination] = candidate;
+                    paths.parents[destination] = source;
+                    paths.nearest_sources[destination] = paths.nearest_sources[source];
+                    buckets[candidate % bucket_count].push_back(destination);
+                    pending++;
+                }
+            }
+        }
+    }
+
+    return paths;
+}
+
+// Direction-optimising BFS switches to bottom-up once the frontier's edges are over 1/ALPHA of the
+// unexplored edges, and back to top-down once the frontier shrinks under 1/BETA of the nodes
+inline constexpr long BFS_ALPHA = 14;
+inline constexpr long BFS_BETA = 24;
+
+/**
+ * Breadth-first search for graphs where every edge has the same weight, same result as heap_search.
+ *
+ * Small frontiers are expanded top-down over their out-edges. Large frontiers are kept as a bitmap and
+ * every unvisited node instead looks for a parent among its in-edges (bottom-up), stopping at the first
+ * one found, which skips most of the edges once the search has spread. The reversed graph for the
+ * bottom-up steps is built the first time one is needed.
+ *
+ * @param bottom_up_levels if given, set to the number of levels that were expanded bottom-up
+ */
+template<typename AnyGraph>
+ShortestPaths bfs_search(const AnyGraph& graph, const std::vector<long>& sources, long weight = 1, long* bottom_up_levels = nullptr) {
+    const auto node_count = (long)graph.size();
+    auto paths = start_search(graph.size(), sources);
+
+    auto unexplored_edges = (long)graph.edge_count();
+
+    // Sources may repeat, the bitmap keeps each in the frontier once
+    std::vector<uint64_t> frontier_bits((node_count + 63) / 64, 0);
+    std::vector<long> frontier;
+    for (auto source: sources) {
+        if (frontier_bits[source / 64] >> (source % 64) & 1) continue;
+        frontier_bits[source / 64] |= 1ull << (source % 64);
+        frontier.push_back(source);
+    }
+
+    std::optional<decltype(graph.reversed())> reversed;
+    std::vector<long> next;
+    bool bottom_up = false;
+    if (bottom_up_levels != nullptr) *bottom_up_levels = 0;
+
+    for (long level = 1; !frontier.empty(); ++level) {
+        long frontier_edges = 0;
+        for (auto node: frontier) {
+            frontier_edges += (long)graph.edges_of(node).size();
+        }
+        if (!bottom_up) bottom_up = frontier_edges * BFS_ALPHA > unexplored_edges;
+        else bottom_up = (long)frontier.size() * BFS_BETA > node_count;
+        if (bottom_up && bottom_up_levels != nullptr) (*bottom_up_levels)++;
+
+        const long distance = level * weight;
+        next.clear();
+        if (!bottom_up) {
+            for (auto node: frontier) {
+                for (const auto& edge: graph.edges_of(node)) {
+                    const long destination = edge.destination;
+                    if (paths.distances[destination] != std::numeric_limits<long>::max()) continue;
+                    paths.distances[destination] = distance;
+                    paths.parents[destination] = node;
+                    paths.nearest_sources[destination] = paths.nearest_sources[node];
+                    next.push_back(destination);
+                }
+            }
+        } else {
+            if (!reversed.has_value()) reversed.emplace(graph.reversed());
+            frontier_bits.assign((node_count + 63) / 64, 0);
+            for (auto node: frontier) {
+                frontier_bits[node / 64] |= 1ull << (node % 64);
+            }
+
+            for (long node = 0; node < node_count; ++node) {
+                if (paths.distances[node] != std::numeric_limits<long>::max()) continue;
+                for (const auto& edge: reversed->edges_of(node)) {
+                    const long parent = edge.destination;
+                    if ((frontier_bits[parent / 64] >> (parent % 64) & 1) == 0) continue;
+                    paths.distances[node] = distance;
+                    paths.parents[node] = parent;
+                    paths.nearest_sources[node] = paths.nearest_sources[parent];
+                    next.push_back(node);
+                    break;
+                }
+            }
+        }
+
+        unexplored_edges -= frontier_edges;
+        frontier.swap(next);
+    }
+
+    return paths;
+}
+
+/**
+ * Multi-source shortest paths - BFS when all the weights are the same, Dial's buckets when they are small
+ * and a heap otherwise. For the distance from any of several nodes to one target, search from the target
+ * on graph.reversed().
+ */
+template<typename AnyGraph>
+ShortestPaths shortest_paths(const AnyGraph& graph, const std::vector<long>& sources) {
+    if (graph.min_edge_weight() >= 0 && graph.min_edge_weight() == graph.max_edge_weight()) {
+        return bfs_search(graph, sources, graph.max_edge_weight());
+    }
+    if (graph.min_edge_weight() >= 0 && graph.max_edge_weight() <= DIAL_MAX_WEIGHT) {
+        return dial_search(graph, sources, graph.max_edge_weight());
+    }
+    return heap_search(graph, sources);
+}
+
+/**
+ * @param parents if given, filled with the previous node on the shortest path of every node, -1 if none
+ * @return distance of every node from start, max long if unreachable
+ */
+template<typename AnyGraph>
+std::vector<long> dijkstra_distances(const AnyGraph& graph, long start, std::vector<long>* parents = nullptr) {
+    auto paths = shortest_paths(graph, {start});
+    if (parents != nullptr) *parents = std::move(paths.parents);
+    return std::move(paths.distances);
+}
+
+/*
+ * Distances and parents of one search direction. An entry only counts when its stamp matches
+ * the current generation, anything else reads as unvisited.
+ */
+typedef struct SearchLabels {
+    std::vector<uint32_t> stamps;
+    std::vector<long> distances;
+    std::vector<long> parents;
+
+    [[nodiscard]] long distance(long node, uint32_t generation) const {
+        return stamps[node] == generation ? distances[node] : std::numeric_limits<long>::max();
+    }
+
+    void set(long node, uint32_t generation, long distance, long parent) {
+        stamps[node] = generation;
+        distances[node] = distance;
+        parents[node] = parent;
+    }
+} SearchLabels;
+
+/*
+ * Buffers for repeated point-to-point searches on graphs of one size. Every search bumps the generation
+ * instead of clearing the arrays, and the heaps keep their capacity, so a query allocates nothing.
+ */
+class SearchWorkspace {
+    uint32_t generation = 0;
+
+public:
+    SearchLabels forward;
+    SearchLabels backward;
+    std::vector<std::pair<long, long>> forward_heap;
+    std::vector<std::pair<long, long>> backward_heap;
+
+    explicit SearchWorkspace(std::size_t node_count);
+
+    /**
+     * Starts a new search, forgetting the previous one in O(1)
+     *
+     * @return the generation of the new search
+     */
+    uint32_t begin();
+
+    [[nodiscard]] uint32_t current() const { return generation; }
 };
 
+// Min-heap operations over a plain vector, so the storage can be reused between searches
+inline void push_entry(std::vector<std::pair<long, long>>& heap, long distance, long node) {
+    heap.emplace_back(distance, node);
+    std::push_heap(heap.begin(), heap.end(), std::greater<>());
+}
+
+inline std::pair<long, long> pop_entry(std::vector<std::pair<long, long>>& heap) {
+    std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+    auto entry = heap.back();
+    heap.pop_back();
+    return entry;
+}
+
+/**
+ * Dijkstra from source that stops as soon as target is settled. Results stay in workspace.forward
+ * for the workspace's current generation.
+ *
+ * @return distance from source to target, max long if unreachable
+ */
+template<typename AnyGraph>
+long shortest_distance(const AnyGraph& graph, long source, long target, SearchWorkspace& workspace) {
+    const auto generation = workspace.begin();
+    auto& labels = workspace.forward;
+    auto& heap = workspace.forward_heap;
+
+    labels.set(source, generation, 0, -1);
+    push_entry(heap, 0, source);
+
+    while (!heap.empty()) {
+        auto [current_distance, node] = pop_entry(heap);
+        if (current_distance > labels.distance(node, generation)) continue;
+        if (node == target) return current_distance;
+
+        for (const auto& edge: graph.edges_of(node)) {
+            const long destination = edge.destination;
+            const long candidate = current_distance + (long)edge.weight;
+            if (candidate < labels.distance(destination, generation)) {
+                labels.set(destination, generation, candidate, node);
+                push_entry(heap, candidate, destination);
+            }
+        }
+    }
+
+    return std::numeric_limits<long>::max();
+}
+
+/**
+ * Dijkstra from both ends at once for undirected graphs (every edge present both ways), always growing
+ * the smaller frontier. It stops once the two frontiers together cannot beat the best meeting found,
+ * which usually settles far fewer nodes than a one-sided search.
+ *
+ * @param meeting if given, set to the node where the shortest path joins the two halves, -1 if unreachable
+ * @return distance from source to target, max long if unreachable
+ */
+template<typename AnyGraph>
+long bidirectional_distance(const AnyGraph& graph, long source, long target, SearchWorkspace& workspace, long* meeting = nullptr) {
+    const auto generation = workspace.begin();
+    long best = std::numeric_limits<long>::max();
+    long best_meeting = -1;
+
+    workspace.forward.set(source, generation, 0, -1);
+    workspace.backward.set(target, generation, 0, -1);
+    push_entry(workspace.forward_heap, 0, source);
+    push_entry(workspace.backward_heap, 0, target);
+    if (source == target) {
+        best = 0;
+        best_meeting = source;
+    }
+
+    while (!workspace.forward_heap.empty() && !workspace.backward_heap.empty()) {
+        if (workspace.forward_heap.front().first + workspace.backward_heap.front().first >= best) break;
+
+        bool grow_forward = workspace.forward_heap.size() <= workspace.backward_heap.size();
+        auto& labels = grow_forward ? workspace.forward : workspace.backward;
+        auto& other_labels = grow_forward ? workspace.backward : workspace.forward;
+        auto& heap = grow_forward ? workspace.forward_heap : workspace.backward_heap;
+
+        auto [current_distance, node] = pop_entry(heap);
+        if (current_distance > labels.distance(node, generation)) continue;
+
+        for (const auto& edge: graph.edges_of(node)) {
+            const long destination = edge.destination;
+            const long candidate = current_distance + (long)edge.weight;
+            if (candidate < labels.distance(destination, generation)) {
+                labels.set(destination, generation, candidate, node);
+                push_entry(heap, candidate, destination);
+            }
+
+            long other_distance = other_labels.distance(destination, generation);
+            if (other_distance != std::numeric_limits<long>::max() && candidate + other_distance < best) {
+                best = candidate + other_distance;
+                best_meeting = destination;
+            }
+        }
+    }
+
+    if (meeting != nullptr) *meeting = best_meeting;
+    return best;
+}
+
+/**
+ * Nodes of the shortest path found by bidirectional_distance, both ends included, empty if unreachable
+ */
+template<typename AnyGraph>
+std::vector<long> bidirectional_path(const AnyGraph& graph, long source, long target, SearchWorkspace& workspace) {
+    long meeting;
+    bidirectional_distance(graph, source, target, workspace, &meeting);
+    if (meeting == -1) return {};
+
+    std::vector<long> path;
+    for (long node = meeting; node != -1; node = workspace.forward.parents[node]) {
+        path.push_back(node);
+    }
+    std::reverse(path.begin(), path.end());
+    for (long node = workspace.backward.parents[meeting]; node != -1; node = workspace.backward.parents[node]) {
+        path.push_back(node);
+    }
+    return path;
+}
+
+/**
+ * Stops once the target is settled, reusing the workspace between calls
+ *
+ * @return nodes of the shortest path from source to target, both included,
+ *         just the target if it cannot be reached
+ */
+template<typename AnyGraph>
+std::vector<long> dijkstra_path(const AnyGraph& graph, long source, long target, SearchWorkspace& workspace) {
+    if (shortest_distance(graph, source, target, workspace) == std::numeric_limits<long>::max()) return {target};
+
+    std::vector<long> path;
+    for (long node = target; node != -1; node = workspace.forward.parents[node]) {
+        path.push_back(node);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+template<typename AnyGraph>
+std::vector<long> dijkstra_path(const AnyGraph& graph, long source, long target) {
+    SearchWorkspace workspace(graph.size());
+    return dijkstra_path(graph, source, target, workspace);
+}
+
 #endif
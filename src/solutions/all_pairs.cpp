@@ -0,0 +1,74 @@
+#include "all_pairs.h"
+
+#include <array>
+
+DistanceMatrix::DistanceMatrix(std::size_t node_count):
+    node_count(node_count),
+    stride((node_count + DISTANCE_BLOCK - 1) / DISTANCE_BLOCK * DISTANCE_BLOCK),
+    distances(stride * stride, INFINITE) {
+    for (std::size_t node = 0; node < stride; ++node) {
+        distances[node * stride + node] = 0;
+    }
+}
+
+long DistanceMatrix::at(long source, long destination) const {
+    long distance = distances[source * stride + destination];
+    return distance >= INFINITE / 2 ? std::numeric_limits<long>::max() : distance;
+}
+
+void DistanceMatrix::add_edge(long source, long weight, long destination) {
+    long& distance = distances[source * stride + destination];
+    distance = std::min(distance, weight);
+}
+
+// Relaxes block target through block via_row (rows of target, columns k) and via_column (rows k, columns of target).
+// The blocks may be the same, going over k in the outer loop keeps that correct like plain Floyd-Warshall.
+static void relax_block(long *target, const long *via_row, const long *via_column, std::size_t stride) {
+    // Row k is copied out, so the inner loop reads it from its own buffer even when target is via_column
+    std::array<long, DISTANCE_BLOCK> column_row;
+    for (std::size_t k = 0; k < DISTANCE_BLOCK; ++k) {
+        std::copy_n(via_column + k * stride, DISTANCE_BLOCK, column_row.begin());
+        for (std::size_t i = 0; i < DISTANCE_BLOCK; ++i) {
+            const long through = via_row[i * stride + k];
+            long *target_row = target + i * stride;
+            for (std::size_t j = 0; j < DISTANCE_BLOCK; ++j) {
+                target_row[j] = std::min(target_row[j], through + column_row[j]);
+            }
+        }
+    }
+}
+
+void floyd_warshall(DistanceMatrix &matrix) {
+    const std::size_t stride = matrix.row_stride();
+    const std::size_t blocks = stride / DISTANCE_BLOCK;
+    auto block = [&matrix](std::size_t block_row, std::size_t block_column) {
+        return matrix.row((long)(block_row * DISTANCE_BLOCK)) + block_column * DISTANCE_BLOCK;
+    };
+
+    for (std::size_t k = 0; k < blocks; ++k) {
+        relax_block(block(k, k), block(k, k), block(k, k), stride);
+
+        for (std::size_t other = 0; other < blocks; ++other) {
+            if (other == k) continue;
+            relax_block(block(k, other), block(k, k), block(k, other), stride);
+            relax_block(block(other, k), block(other, k), block(k, k), stride);
+        }
+
+        for (std::size_t i = 0; i < blocks; ++i) {
+            if (i == k) continue;
+            for (std::size_t j = 0; j < blocks; ++j) {
+                if (j == k) continue;
+                relax_block(block(i, j), block(i, k), block(k, j), stride);
+            }
+        }
+    }
+
+    // Paths through missing edges may have drifted below INFINITE through negative weights
+    const long unreachable = DistanceMatrix::INFINITE / 2;
+    for (std::size_t source = 0; source < matrix.size(); ++source) {
+        long *row = matrix.row((long)source);
+        for (std::size_t destination = 0; destination < stride; ++destination) {
+            if (row[destination] >= unreachable) row[destination] = DistanceMatrix::INFINITE;
+        }
+    }
+}
@@ -0,0 +1,158 @@
+#ifndef AOC_ALL_PAIRS_H
+#define AOC_ALL_PAIRS_H
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "Graph.h"
+
+// Floyd-Warshall works on square blocks of this many rows and columns, 32 x 32 longs are 8 KiB
+inline constexpr std::size_t DISTANCE_BLOCK = 32;
+
+/*
+ * Dense distance matrix in one flat row-major array. Both sides are padded to a multiple of DISTANCE_BLOCK,
+ * so the blocked Floyd-Warshall needs no edge cases.
+ */
+class DistanceMatrix {
+    std::size_t node_count;
+    std::size_t stride;
+    std::vector<long> distances;
+
+public:
+    // Stored for missing paths, small enough that adding two of them cannot overflow
+    static constexpr long INFINITE = std::numeric_limits<long>::max() / 4;
+
+    /**
+     * Every node is at 0 from itself and unreachable from the others
+     */
+    explicit DistanceMatrix(std::size_t node_count);
+
+    [[nodiscard]] std::size_t size() const { return node_count; }
+    [[nodiscard]] std::size_t row_stride() const { return stride; }
+
+    /**
+     * @return distance from source to destination, max long if unreachable
+     */
+    [[nodiscard]] long at(long source, long destination) const;
+
+    /**
+     * Keeps the lighter of the existing and the new edge
+     */
+    void add_edge(long source, long weight, long destination);
+
+    [[nodiscard]] long* row(long source) { return distances.data() + source * stride; }
+    [[nodiscard]] const long* row(long source) const { return distances.data() + source * stride; }
+};
+
+/**
+ * All-pairs shortest paths in place. Cache-blocked Floyd-Warshall: for every diagonal block k, the block
+ * itself is closed first, then its row and column of blocks, then all the other blocks through them.
+ * The inner loop is a branch-free min-plus over a block row that stays in cache for the whole block.
+ * Negative weights are fine as long as there is no negative cycle.
+ */
+void floyd_warshall(DistanceMatrix& matrix);
+
+/**
+ * All-pairs distances of any graph with size() and edges_of(node), meant for up to a few thousand nodes
+ */
+template<typename AnyGraph>
+DistanceMatrix all_pairs_distances(const AnyGraph& graph) {
+    DistanceMatrix matrix(graph.size());
+    for (long node = 0; node < (long)graph.size(); ++node) {
+        for (const auto& edge: graph.edges_of(node)) {
+            matrix.add_edge(node, (long)edge.weight, (long)edge.destination);
+        }
+    }
+    floyd_warshall(matrix);
+    return matrix;
+}
+
+/**
+ * Shrinks a big graph with uniform edge weights to a graph between distinct points of interest. Node i of the result
+ * is key_points[i], and it has an edge to every key point reachable without passing through another key point,
+ * weighing the length of that path. Distances between key points stay the same, so the small graph can go
+ * to all_pairs_distances or any other search.
+ *
+ * Bit-parallel multi-source BFS: batches of 64 key points are searched at once, each node keeps a bit per
+ * search in the batch and the frontier holds every node reached by at least one of them, so expanding it
+ * once advances all 64 searches by a level. A batch costs O(V + E) however long the paths are.
+ *
+ * @throws std::logic_error if the edge weights are not all the same
+ */
+template<typename AnyGraph>
+Graph compress_key_points(const AnyGraph& graph, const std::vector<long>& key_points) {
+    if (graph.min_edge_weight() != graph.max_edge_weight()) {
+        throw std::logic_error("Key point compression needs uniform edge weights");
+    }
+    const long weight = graph.max_edge_weight();
+    const std::size_t node_count = graph.size();
+
+    // Index into key_points of every node, -1 for the others
+    std::vector<long> key_index(node_count, -1);
+    for (std::size_t i = 0; i < key_points.size(); ++i) {
+        key_index[key_points[i]] = (long)i;
+    }
+
+    Graph compressed(key_points.size());
+    std::vector<uint64_t> seen(node_count), visit(node_count), next(node_count);
+    std::vector<long> frontier, next_frontier;
+    for (std::size_t batch = 0; batch < key_points.size(); batch += 64) {
+        const std::size_t batch_size = std::min<std::size_t>(64, key_points.size() - batch);
+        std::fill(seen.begin(), seen.end(), 0);
+        frontier.clear();
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            const long key_point = key_points[batch + i];
+            if (visit[key_point] == 0) frontier.push_back(key_point);
+            seen[key_point] |= 1ull << i;
+            visit[key_point] |= 1ull << i;
+        }
+
+        // visit and next are only ever non-zero on the nodes of frontier and next_frontier
+        for (long level = 1; !frontier.empty(); ++level) {
+            next_frontier.clear();
+            for (auto node: frontier) {
+                uint64_t searches = visit[node];
+                visit[node] = 0;
+
+                // Key points are reached but not crossed, except by their own search
+                const long key = key_index[node];
+                if (key != -1) {
+                    const long offset = key - (long)batch;
+                    searches &= 0 <= offset && offset < 64 ? 1ull << offset : 0;
+                }
+
+                for (const auto& edge: graph.edges_of(node)) {
+                    const long destination = edge.destination;
+                    const uint64_t arriving = searches & ~seen[destination];
+                    if (arriving == 0) continue;
+                    if (next[destination] == 0) next_frontier.push_back(destination);
+                    next[destination] |= arriving;
+                    seen[destination] |= arriving;
+                }
+            }
+
+            for (auto node: next_frontier) {
+                if (key_index[node] == -1) continue;
+                for (uint64_t searches = next[node]; searches != 0; searches &= searches - 1) {
+                    compressed.add_directed_edge((long)batch + std::countr_zero(searches), level * weight, key_index[node]);
+                }
+            }
+            std::swap(visit, next);
+            std::swap(frontier, next_frontier);
+        }
+    }
+
+    return compressed;
+}
+
+/**
+ * @return distances between all the key points, indexed like key_points
+ */
+template<typename AnyGraph>
+DistanceMatrix key_point_distances(const AnyGraph& graph, const std::vector<long>& key_points) {
+    return all_pairs_distances(compress_key_points(graph, key_points));
+}
+
+#endif
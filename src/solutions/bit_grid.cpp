@@ -0,0 +1,218 @@
+#include "bit_grid.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <stdexcept>
+
+static constexpr std::size_t WORD_BITS = 64;
+
+// Mask of bits from..to (both inclusive) inside one word
+static uint64_t bit_range_mask(std::size_t from, std::size_t to) {
+    uint64_t upper = (to == WORD_BITS - 1) ? ~0ull : ((1ull << (to + 1)) - 1);
+    uint64_t lower = (1ull << from) - 1;
+    return upper & ~lower;
+}
+
+static uint64_t tail_mask(std::size_t columns) {
+    return (columns % WORD_BITS == 0) ? ~0ull : ((1ull << (columns % WORD_BITS)) - 1);
+}
+
+BitGrid::BitGrid(std::size_t rows, std::size_t columns):
+    rows(rows),
+    columns(columns),
+    words_per_row((columns + WORD_BITS - 1) / WORD_BITS),
+    words(rows * ((columns + WORD_BITS - 1) / WORD_BITS), 0) {}
+
+bool BitGrid::test(const GridCell &cell) const noexcept {
+    if (cell.row < 0 || cell.row >= rows || cell.column < 0 || cell.column >= columns) return false;
+    return (row(cell.row)[cell.column / WORD_BITS] >> (cell.column % WORD_BITS)) & 1;
+}
+
+bool BitGrid::set(const GridCell &cell, bool value) {
+    if (cell.row < 0 || cell.row >= rows || cell.column < 0 || cell.column >= columns) return false;
+
+    uint64_t bit = 1ull << (cell.column % WORD_BITS);
+    uint64_t &word = row(cell.row)[cell.column / WORD_BITS];
+    word = value ? (word | bit) : (word & ~bit);
+    return true;
+}
+
+bool BitGrid::flip(const GridCell &cell) {
+    if (cell.row < 0 || cell.row >= rows || cell.column < 0 || cell.column >= columns) return false;
+
+    row(cell.row)[cell.column / WORD_BITS] ^= 1ull << (cell.column % WORD_BITS);
+    return true;
+}
+
+uint64_t *BitGrid::row(std::size_t row) {
+    return words.data() + row * words_per_row;
+}
+
+const uint64_t *BitGrid::row(std::size_t row) const {
+    return words.data() + row * words_per_row;
+}
+
+template<typename Op>
+static void combine_rows(uint64_t *__restrict target, const uint64_t *__restrict source, std::size_t count, Op op) {
+    for (std::size_t i = 0; i < count; ++i) {
+        target[i] = op(target[i], source[i]);
+    }
+}
+
+void BitGrid::and_row(std::size_t row, const BitGrid &other, std::size_t other_row) {
+    if (other.columns != columns) throw std::logic_error("Rows must be of the same length");
+    if (&other == this && row == other_row) return;
+    combine_rows(this->row(row), other.row(other_row), words_per_row, [](auto a, auto b) { return a & b; });
+}
+
+void BitGrid::or_row(std::size_t row, const BitGrid &other, std::size_t other_row) {
+    if (other.columns != columns) throw std::logic_error("Rows must be of the same length");
+    if (&other == this && row == other_row) return;
+    combine_rows(this->row(row), other.row(other_row), words_per_row, [](auto a, auto b) { return a | b; });
+}
+
+void BitGrid::xor_row(std::size_t row, const BitGrid &other, std::size_t other_row) {
+    if (other.columns != columns) throw std::logic_error("Rows must be of the same length");
+    if (&other == this && row == other_row) {
+        std::fill(this->row(row), this->row(row) + words_per_row, 0);
+        return;
+    }
+    combine_rows(this->row(row), other.row(other_row), words_per_row, [](auto a, auto b) { return a ^ b; });
+}
+
+void BitGrid::shift_row(std::size_t row, long by) {
+    uint64_t *r = this->row(row);
+    auto count = (long)words_per_row;
+    if (by == 0 || count == 0) return;
+
+    if ((std::size_t)std::abs(by) >= columns) {
+        std::fill(r, r + count, 0);
+        return;
+    }
+
+    long word_shift = std::abs(by) / (long)WORD_BITS;
+    long bit_shift = std::abs(by) % (long)WORD_BITS;
+
+    if (by > 0) {
+        // Towards higher columns, which are the higher bits
+        for (long i = count - 1; i >= 0; --i) {
+            long source = i - word_shift;
+            uint64_t high = source >= 0 ? r[source] << bit_shift : 0;
+            uint64_t low = (bit_shift != 0 && source - 1 >= 0) ? r[source - 1] >> (WORD_BITS - bit_shift) : 0;
+            r[i] = high | low;
+        }
+    } else {
+        for (long i = 0; i < count; ++i) {
+            long source = i + word_shift;
+            uint64_t low = source < count ? r[source] >> bit_shift : 0;
+            uint64_t high = (bit_shift != 0 && source + 1 < count) ? r[source + 1] << (WORD_BITS - bit_shift) : 0;
+            r[i] = high | low;
+        }
+    }
+
+    r[count - 1] &= tail_mask(columns);
+}
+
+BitGrid &BitGrid::operator&=(const BitGrid &other) {
+    if (other.rows != rows || other.columns != columns) throw std::logic_error("Grids must be of the same size");
+    combine_rows(words.data(), other.words.data(), words.size(), [](auto a, auto b) { return a & b; });
+    return *this;
+}
+
+BitGrid &BitGrid::operator|=(const BitGrid &other) {
+    if (other.rows != rows || other.columns != columns) throw std::logic_error("Grids must be of the same size");
+    combine_rows(words.data(), other.words.data(), words.size(), [](auto a, auto b) { return a | b; });
+    return *this;
+}
+
+BitGrid &BitGrid::operator^=(const BitGrid &other) {
+    if (other.rows != rows || other.columns != columns) throw std::logic_error("Grids must be of the same size");
+    combine_rows(words.data(), other.words.data(), words.size(), [](auto a, auto b) { return a ^ b; });
+    return *this;
+}
+
+bool BitGrid::operator==(const BitGrid &other) const {
+    return rows == other.rows && columns == other.columns && words == other.words;
+}
+
+// Runs op(word, mask) over every word touched by the rectangle, clipped to the grid
+template<typename Op>
+static void apply_rect(BitGrid &grid, const GridCell &from, const GridCell &to, Op op) {
+    long first_row = std::max(0l, std::min(from.row, to.row));
+    long last_row = std::min((long)grid.rows - 1, std::max(from.row, to.row));
+    long first_column = std::max(0l, std::min(from.column, to.column));
+    long last_column = std::min((long)grid.columns - 1, std::max(from.column, to.column));
+    if (first_row > last_row || first_column > last_column) return;
+
+    std::size_t first_word = first_column / WORD_BITS;
+    std::size_t last_word = last_column / WORD_BITS;
+
+    for (long row = first_row; row <= last_row; ++row) {
+        uint64_t *r = grid.row(row);
+        if (first_word == last_word) {
+            op(r[first_word], bit_range_mask(first_column % WORD_BITS, last_column % WORD_BITS));
+            continue;
+        }
+
+        op(r[first_word], bit_range_mask(first_column % WORD_BITS, WORD_BITS - 1));
+        for (std::size_t word = first_word + 1; word < last_word; ++word) {
+            op(r[word], ~0ull);
+        }
+        op(r[last_word], bit_range_mask(0, last_column % WORD_BITS));
+    }
+}
+
+void BitGrid::fill_rect(const GridCell &from, const GridCell &to, bool value) {
+    if (value) {
+        apply_rect(*this, from, to, [](uint64_t &word, uint64_t mask) { word |= mask; });
+    } else {
+        apply_rect(*this, from, to, [](uint64_t &word, uint64_t mask) { word &= ~mask; });
+    }
+}
+
+void BitGrid::toggle_rect(const GridCell &from, const GridCell &to) {
+    apply_rect(*this, from, to, [](uint64_t &word, uint64_t mask) { word ^= mask; });
+}
+
+std::size_t BitGrid::popcount() const {
+    std::size_t count = 0;
+    for (auto word: words) {
+        count += std::popcount(word);
+    }
+    return count;
+}
+
+std::size_t BitGrid::popcount_row(std::size_t row) const {
+    std::size_t count = 0;
+    const uint64_t *r = this->row(row);
+    for (std::size_t i = 0; i < words_per_row; ++i) {
+        count += std::popcount(r[i]);
+    }
+    return count;
+}
+
+BitGrid make_bit_grid(const Grid &grid, char set_char) {
+    BitGrid bit_grid(grid.rows, grid.columns);
+    for (std::size_t row = 0; row < grid.rows; ++row) {
+        const char *cells = grid.data.data() + grid.storage_idx({(long)row, 0});
+        uint64_t *r = bit_grid.row(row);
+        for (std::size_t column = 0; column < grid.columns; ++column) {
+            r[column / WORD_BITS] |= (uint64_t)(cells[column] == set_char) << (column % WORD_BITS);
+        }
+    }
+    return bit_grid;
+}
+
+Grid make_grid(const BitGrid &bit_grid, char set_char, char unset_char) {
+    Grid grid = make_grid(bit_grid.rows, bit_grid.columns, unset_char);
+    for (std::size_t row = 0; row < bit_grid.rows; ++row) {
+        const uint64_t *r = bit_grid.row(row);
+        for (std::size_t column = 0; column < bit_grid.columns; ++column) {
+            if ((r[column / WORD_BITS] >> (column % WORD_BITS)) & 1) {
+                grid.data[grid.storage_idx({(long)row, (long)column})] = set_char;
+            }
+        }
+    }
+    return grid;
+}
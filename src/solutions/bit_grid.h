@@ -0,0 +1,75 @@
+#ifndef AOC_BIT_GRID_H
+#define AOC_BIT_GRID_H
+
+#include <cstdint>
+#include <vector>
+#include "grid.h"
+
+/*
+ * Grid of booleans packed 64 cells to a word. Every row starts at a new word and the bits past
+ * the last column are always kept at zero, so the bulk operations can just run over whole words.
+ * Those are plain loops over `uint64_t`, which the compiler vectorises.
+ */
+typedef struct BitGrid {
+    std::size_t rows = 0;
+    std::size_t columns = 0;
+    std::size_t words_per_row = 0;
+    std::vector<uint64_t> words;
+
+    BitGrid() = default;
+    BitGrid(std::size_t rows, std::size_t columns);
+
+    /**
+     * @return whether the cell is set, cells outside of the grid are never set
+     */
+    [[nodiscard]] bool test(const GridCell& cell) const noexcept;
+
+    /**
+     * Sets the cell to value
+     *
+     * @return true if the position is inside grid, false if it is outside
+     */
+    bool set(const GridCell& cell, bool value = true);
+    bool flip(const GridCell& cell);
+
+    [[nodiscard]] uint64_t* row(std::size_t row);
+    [[nodiscard]] const uint64_t* row(std::size_t row) const;
+
+    // Row operations, the other row may come from the same grid
+    void and_row(std::size_t row, const BitGrid& other, std::size_t other_row);
+    void or_row(std::size_t row, const BitGrid& other, std::size_t other_row);
+    void xor_row(std::size_t row, const BitGrid& other, std::size_t other_row);
+
+    /**
+     * Moves all cells of the row by `by` columns, positive towards higher columns.
+     * Cells moved past the edge are dropped, vacated ones are cleared.
+     */
+    void shift_row(std::size_t row, long by);
+
+    // Whole grid operations, both grids must be of the same size
+    BitGrid& operator&=(const BitGrid& other);
+    BitGrid& operator|=(const BitGrid& other);
+    BitGrid& operator^=(const BitGrid& other);
+    bool operator==(const BitGrid& other) const;
+
+    /**
+     * Sets every cell in the rectangle between from and to (both inclusive) to value
+     */
+    void fill_rect(const GridCell& from, const GridCell& to, bool value = true);
+
+    /**
+     * Flips every cell in the rectangle between from and to (both inclusive)
+     */
+    void toggle_rect(const GridCell& from, const GridCell& to);
+
+    [[nodiscard]] std::size_t popcount() const;
+    [[nodiscard]] std::size_t popcount_row(std::size_t row) const;
+} BitGrid;
+
+/**
+ * @return bit grid with cells set wherever grid has set_char
+ */
+BitGrid make_bit_grid(const Grid& grid, char set_char);
+Grid make_grid(const BitGrid& bit_grid, char set_char = '#', char unset_char = '.');
+
+#endif
@@ -0,0 +1,49 @@
+#include "cell_set.h"
+
+#include <algorithm>
+
+void CellSet::rehash(std::size_t capacity) {
+    std::vector<uint64_t> old_keys(capacity, cell_table::EMPTY_KEY);
+    old_keys.swap(keys);
+
+    for (auto key: old_keys) {
+        if (key == cell_table::EMPTY_KEY) continue;
+        keys[cell_table::find_slot(keys, key)] = key;
+    }
+}
+
+bool CellSet::insert(PackedCell cell) {
+    auto slot = cell_table::find_slot(keys, cell.key());
+    if (keys[slot] == cell.key()) return false;
+
+    if (cell_table::needs_growth(count, keys.size())) {
+        rehash(keys.size() * 2);
+        slot = cell_table::find_slot(keys, cell.key());
+    }
+    keys[slot] = cell.key();
+    count++;
+    return true;
+}
+
+bool CellSet::erase(PackedCell cell) {
+    auto slot = cell_table::find_slot(keys, cell.key());
+    if (keys[slot] != cell.key()) return false;
+
+    cell_table::erase_slot(keys, slot, [](std::size_t, std::size_t) {});
+    count--;
+    return true;
+}
+
+bool CellSet::contains(PackedCell cell) const {
+    return keys[cell_table::find_slot(keys, cell.key())] == cell.key();
+}
+
+void CellSet::reserve(std::size_t elements) {
+    auto capacity = cell_table::capacity_for(elements);
+    if (capacity > keys.size()) rehash(capacity);
+}
+
+void CellSet::clear() {
+    std::fill(keys.begin(), keys.end(), cell_table::EMPTY_KEY);
+    count = 0;
+}
@@ -0,0 +1,246 @@
+#ifndef AOC_CELL_SET_H
+#define AOC_CELL_SET_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "grid.h"
+
+/*
+ * Grid coordinates squeezed into one 64-bit word, both halves must fit into int32.
+ * Converts to and from GridCell implicitly, so it can be dropped in wherever cells are stored.
+ */
+typedef struct PackedCell {
+    int32_t row;
+    int32_t column;
+
+    PackedCell() = default;
+    constexpr PackedCell(int32_t row, int32_t column): row(row), column(column) {}
+
+    /**
+     * @throws std::out_of_range if a coordinate does not fit into int32
+     */
+    PackedCell(const GridCell& cell): row(narrow(cell.row)), column(narrow(cell.column)) {}
+
+    operator GridCell() const { return GridCell{row, column}; }
+
+    [[nodiscard]] constexpr uint64_t key() const {
+        return ((uint64_t)(uint32_t)row << 32) | (uint32_t)column;
+    }
+
+    static constexpr PackedCell from_key(uint64_t key) {
+        return PackedCell{(int32_t)(uint32_t)(key >> 32), (int32_t)(uint32_t)key};
+    }
+
+    bool operator==(const PackedCell& other) const { return key() == other.key(); }
+    bool operator!=(const PackedCell& other) const { return key() != other.key(); }
+
+private:
+    static int32_t narrow(long coordinate) {
+        if (coordinate < std::numeric_limits<int32_t>::min() || coordinate > std::numeric_limits<int32_t>::max()) {
+            throw std::out_of_range("The cell does not fit into a PackedCell");
+        }
+        return (int32_t)coordinate;
+    }
+} PackedCell;
+
+/**
+ * Full avalanche mix of the packed coordinates (splitmix64 finalizer), nearby cells end up far apart
+ */
+constexpr uint64_t hash_cell(uint64_t key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ull;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebull;
+    key ^= key >> 31;
+    return key;
+}
+
+namespace cell_table {
+    // Marks an empty slot, which makes {INT32_MIN, INT32_MIN} the one cell that cannot be stored
+    inline constexpr uint64_t EMPTY_KEY = PackedCell{std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::min()}.key();
+
+    // Keep the load under 3/4, linear probing degrades quickly past that
+    inline bool needs_growth(std::size_t size, std::size_t capacity) {
+        return (size + 1) * 4 > capacity * 3;
+    }
+
+    inline std::size_t capacity_for(std::size_t elements) {
+        std::size_t capacity = 16;
+        while (elements * 4 > capacity * 3) capacity *= 2;
+        return capacity;
+    }
+
+    /**
+     * @return slot holding the key, or the empty slot where it would go
+     */
+    inline std::size_t find_slot(const std::vector<uint64_t>& keys, uint64_t key) {
+        if (key == EMPTY_KEY) throw std::out_of_range("This cell is reserved as the empty marker");
+
+        const std::size_t mask = keys.size() - 1;
+        std::size_t slot = hash_cell(key) & mask;
+        while (keys[slot] != key && keys[slot] != EMPTY_KEY) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    /**
+     * Empties the slot and shifts back the following entries of its cluster, so no tombstones are needed.
+     * move_value(from, to) lets the caller move its parallel value array along.
+     */
+    template<typename MoveValue>
+    void erase_slot(std::vector<uint64_t>& keys, std::size_t slot, MoveValue move_value) {
+        const std::size_t mask = keys.size() - 1;
+        std::size_t hole = slot;
+        std::size_t next = (hole + 1) & mask;
+        while (keys[next] != EMPTY_KEY) {
+            std::size_t home = hash_cell(keys[next]) & mask;
+            // Can the entry at next move into the hole without passing its home slot?
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                keys[hole] = keys[next];
+                move_value(next, hole);
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+        keys[hole] = EMPTY_KEY;
+    }
+}
+
+/*
+ * Flat open-addressing set of cells - one array of packed keys, linear probing, no per-insert allocation.
+ * The cell {INT32_MIN, INT32_MIN} is reserved as the empty marker, using it throws std::out_of_range.
+ */
+class CellSet {
+    std::vector<uint64_t> keys;
+    std::size_t count = 0;
+
+    void rehash(std::size_t capacity);
+
+public:
+    CellSet(): keys(16, cell_table::EMPTY_KEY) {}
+
+    /**
+     * @return true if the cell was not in the set before
+     */
+    bool insert(PackedCell cell);
+    bool erase(PackedCell cell);
+    [[nodiscard]] bool contains(PackedCell cell) const;
+
+    void reserve(std::size_t elements);
+    void clear();
+
+    [[nodiscard]] std::size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+
+    /**
+     * Calls fn(GridCell) for every cell in the set, in no particular order
+     */
+    template<typename Fn>
+    void for_each(Fn fn) const {
+        for (auto key: keys) {
+            if (key != cell_table::EMPTY_KEY) fn(GridCell(PackedCell::from_key(key)));
+        }
+    }
+};
+
+/*
+ * Flat open-addressing map from cells to values, keys and values live in two parallel arrays.
+ * Same as CellSet, the cell {INT32_MIN, INT32_MIN} is reserved.
+ */
+template<typename Value>
+class CellMap {
+    std::vector<uint64_t> keys;
+    std::vector<Value> values;
+    std::size_t count = 0;
+
+    void rehash(std::size_t capacity) {
+        std::vector<uint64_t> old_keys(capacity, cell_table::EMPTY_KEY);
+        std::vector<Value> old_values(capacity);
+        old_keys.swap(keys);
+        old_values.swap(values);
+
+        for (std::size_t i = 0; i < old_keys.size(); ++i) {
+            if (old_keys[i] == cell_table::EMPTY_KEY) continue;
+            auto slot = cell_table::find_slot(keys, old_keys[i]);
+            keys[slot] = old_keys[i];
+            values[slot] = std::move(old_values[i]);
+        }
+    }
+
+public:
+    CellMap(): keys(16, cell_table::EMPTY_KEY), values(16) {}
+
+    /**
+     * @return value of the cell, default constructed and inserted if missing
+     */
+    Value& operator[](PackedCell cell) {
+        auto slot = cell_table::find_slot(keys, cell.key());
+        if (keys[slot] == cell.key()) return values[slot];
+
+        if (cell_table::needs_growth(count, keys.size())) {
+            rehash(keys.size() * 2);
+            slot = cell_table::find_slot(keys, cell.key());
+        }
+        keys[slot] = cell.key();
+        values[slot] = Value{};
+        count++;
+        return values[slot];
+    }
+
+    /**
+     * @return pointer to the value of the cell, nullptr if it is not in the map
+     */
+    Value* find(PackedCell cell) {
+        auto slot = cell_table::find_slot(keys, cell.key());
+        return keys[slot] == cell.key() ? &values[slot] : nullptr;
+    }
+
+    const Value* find(PackedCell cell) const {
+        auto slot = cell_table::find_slot(keys, cell.key());
+        return keys[slot] == cell.key() ? &values[slot] : nullptr;
+    }
+
+    [[nodiscard]] bool contains(PackedCell cell) const {
+        return find(cell) != nullptr;
+    }
+
+    bool erase(PackedCell cell) {
+        auto slot = cell_table::find_slot(keys, cell.key());
+        if (keys[slot] != cell.key()) return false;
+
+        cell_table::erase_slot(keys, slot, [this](std::size_t from, std::size_t to) {
+            values[to] = std::move(values[from]);
+        });
+        count--;
+        return true;
+    }
+
+    void reserve(std::size_t elements) {
+        auto capacity = cell_table::capacity_for(elements);
+        if (capacity > keys.size()) rehash(capacity);
+    }
+
+    void clear() {
+        std::fill(keys.begin(), keys.end(), cell_table::EMPTY_KEY);
+        count = 0;
+    }
+
+    [[nodiscard]] std::size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+
+    /**
+     * Calls fn(GridCell, Value&) for every entry, in no particular order
+     */
+    template<typename Fn>
+    void for_each(Fn fn) {
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            if (keys[i] != cell_table::EMPTY_KEY) fn(GridCell(PackedCell::from_key(keys[i])), values[i]);
+        }
+    }
+};
+
+#endif
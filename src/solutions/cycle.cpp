@@ -0,0 +1,6 @@
+#include "cycle.h"
+
+std::size_t Cycle::equivalent_step(std::size_t steps) const {
+    if (steps < start || length == 0) return steps;
+    return start + (steps - start) % length;
+}
@@ -0,0 +1,89 @@
+#ifndef AOC_CYCLE_H
+#define AOC_CYCLE_H
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+
+/*
+ * Cycle of a deterministic simulation: the state after step `start` repeats every `length` steps
+ */
+typedef struct Cycle {
+    std::size_t start;
+    std::size_t length;
+
+    /**
+     * @return the smallest step count giving the same state as running `steps` steps
+     */
+    [[nodiscard]] std::size_t equivalent_step(std::size_t steps) const;
+} Cycle;
+
+/**
+ * Brent's cycle detection, only ever keeps two states alive. Keys are compared first as a cheap filter,
+ * so key(state) is usually a state hash or the packed state itself. Keys may collide, a match only counts
+ * once equal(a, b) confirms the states themselves are the same.
+ *
+ * @param step called as step(const State&) and returns the next state
+ * @param max_steps gives up once the hare has taken this many steps
+ * @param equal called as equal(const State&, const State&) on a key match, operator== by default
+ * @return the cycle, or nothing if none shows up within max_steps
+ */
+template<typename State, typename Step, typename Key, typename Equal = std::equal_to<>>
+std::optional<Cycle> find_cycle(const State& initial, Step step, Key key, std::size_t max_steps, Equal equal = {}) {
+    auto same = [&key, &equal](const State& a, const State& b) {
+        return key(a) == key(b) && equal(a, b);
+    };
+
+    // 1. Find the length: the tortoise teleports to the hare at every power of two
+    std::size_t power = 1;
+    std::size_t length = 1;
+    std::size_t taken = 1;
+    State tortoise = initial;
+    State hare = step(initial);
+    while (!same(tortoise, hare)) {
+        if (taken >= max_steps) return std::nullopt;
+        if (power == length) {
+            tortoise = hare;
+            power *= 2;
+            length = 0;
+        }
+        hare = step(hare);
+        length++;
+        taken++;
+    }
+
+    // 2. Find the start: walk both from the beginning, `length` steps apart, until they meet
+    tortoise = initial;
+    hare = initial;
+    for (std::size_t i = 0; i < length; ++i) {
+        hare = step(hare);
+    }
+    std::size_t start = 0;
+    while (!same(tortoise, hare)) {
+        tortoise = step(tortoise);
+        hare = step(hare);
+        start++;
+    }
+
+    return Cycle{start, length};
+}
+
+/**
+ * State after `steps` steps. Once a cycle is found, only the steps up to the equivalent
+ * step inside the first lap are replayed, the rest are skipped. The search for the cycle
+ * is capped at `steps`, so if there is none by then every step is simulated once more
+ * on top of the search, about twice the cost of plain simulation.
+ */
+template<typename State, typename Step, typename Key, typename Equal = std::equal_to<>>
+State fast_forward(const State& initial, Step step, Key key, std::size_t steps, Equal equal = {}) {
+    auto cycle = find_cycle(initial, step, key, steps, equal);
+    std::size_t remaining = cycle.has_value() ? cycle->equivalent_step(steps) : steps;
+
+    State state = initial;
+    for (std::size_t i = 0; i < remaining; ++i) {
+        state = step(state);
+    }
+    return state;
+}
+
+#endif
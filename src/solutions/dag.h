@@ -0,0 +1,198 @@
+#ifndef AOC_DAG_H
+#define AOC_DAG_H
+
+#include <array>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+// Operand slot of a DAG node that reads a constant instead of another node
+inline constexpr long DAG_CONSTANT = -1;
+
+/*
+ * One node of the DAG before sorting - op(values of the operands). An operand reads node inputs[i],
+ * or constants[i] when inputs[i] is DAG_CONSTANT. Unused operands are left as constants.
+ */
+template<typename Value>
+struct DagNode {
+    int op;
+    std::array<long, 2> inputs = {DAG_CONSTANT, DAG_CONSTANT};
+    std::array<Value, 2> constants = {};
+};
+
+/*
+ * Evaluates a DAG of nodes with up to two operands. The nodes are sorted topologically once into a flat
+ * array of instructions whose operands are positions in that array, so a full evaluation is one linear pass
+ * with every operand already computed. Dependents are kept in one CSR array, so overriding a value only
+ * recomputes the nodes downstream of it, in topological order and stopping where values do not change.
+ */
+template<typename Value, typename Apply>
+class DagEvaluator {
+    typedef struct Instruction {
+        int op;
+        // Positions of the operands in values, DAG_CONSTANT for constants
+        std::array<long, 2> inputs;
+        std::array<Value, 2> constants;
+    } Instruction;
+
+    Apply apply;
+    std::vector<Instruction> instructions;
+    std::vector<Value> values;
+    // Node id -> position in instructions
+    std::vector<long> positions;
+    // Positions reading position p are dependents[dependent_offsets[p]..dependent_offsets[p + 1])
+    std::vector<long> dependent_offsets;
+    std::vector<long> dependents;
+    std::vector<bool> overridden;
+    std::vector<bool> queued;
+
+    [[nodiscard]] Value compute(long position) const {
+        const auto& instruction = instructions[position];
+        std::array<Value, 2> operands;
+        for (std::size_t i = 0; i < 2; ++i) {
+            operands[i] = instruction.inputs[i] == DAG_CONSTANT ? instruction.constants[i] : values[instruction.inputs[i]];
+        }
+        return apply(instruction.op, operands[0], operands[1]);
+    }
+
+    // Recomputes everything downstream of position that changes, lowest position first
+    void propagate(long position) {
+        std::priority_queue<long, std::vector<long>, std::greater<>> pending;
+        auto enqueue_dependents = [&](long from) {
+            for (long i = dependent_offsets[from]; i < dependent_offsets[from + 1]; ++i) {
+                if (queued[dependents[i]]) continue;
+                queued[dependents[i]] = true;
+                pending.push(dependents[i]);
+            }
+        };
+
+        enqueue_dependents(position);
+        while (!pending.empty()) {
+            long current = pending.top();
+            pending.pop();
+            queued[current] = false;
+            if (overridden[current]) continue;
+
+            Value value = compute(current);
+            if (value == values[current]) continue;
+            values[current] = value;
+            enqueue_dependents(current);
+        }
+    }
+
+public:
+    /**
+     * Sorts and evaluates the nodes
+     *
+     * @param apply called as apply(op, a, b) for the value of a node
+     * @throws std::logic_error if the nodes form a cycle or an input is out of range
+     */
+    DagEvaluator(const std::vector<DagNode<Value>>& nodes, Apply apply):
+        apply(apply),
+        positions(nodes.size(), -1),
+        dependent_offsets(nodes.size() + 1, 0),
+        overridden(nodes.size(), false),
+        queued(nodes.size(), false) {
+        const auto node_count = (long)nodes.size();
+
+        // Kahn's algorithm over node ids, the dependents double as the adjacency of the sort
+        std::vector<long> missing_inputs(node_count, 0);
+        std::vector<long> node_offsets(node_count + 1, 0);
+        for (const auto& node: nodes) {
+            for (long input: node.inputs) {
+                if (input == DAG_CONSTANT) continue;
+                if (input < 0 || input >= node_count) throw std::logic_error("DAG input out of range");
+                node_offsets[input + 1]++;
+            }
+        }
+        for (long node = 0; node < node_count; ++node) {
+            node_offsets[node + 1] += node_offsets[node];
+        }
+        std::vector<long> node_dependents(node_offsets.back());
+        std::vector<long> fill(node_offsets.begin(), node_offsets.end() - 1);
+        for (long node = 0; node < node_count; ++node) {
+            for (long input: nodes[node].inputs) {
+                if (input == DAG_CONSTANT) continue;
+                node_dependents[fill[input]++] = node;
+                missing_inputs[node]++;
+            }
+        }
+
+        std::vector<long> order;
+        order.reserve(node_count);
+        for (long node = 0; node < node_count; ++node) {
+            if (missing_inputs[node] == 0) order.push_back(node);
+        }
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            for (long d = node_offsets[order[i]]; d < node_offsets[order[i] + 1]; ++d) {
+                if (--missing_inputs[node_dependents[d]] == 0) order.push_back(node_dependents[d]);
+            }
+        }
+        if ((long)order.size() != node_count) throw std::logic_error("DAG has a cycle");
+
+        for (long position = 0; position < node_count; ++position) {
+            positions[order[position]] = position;
+        }
+
+        // Instructions and dependents renumbered to positions
+        instructions.reserve(node_count);
+        dependents.resize(node_dependents.size());
+        for (long position = 0; position < node_count; ++position) {
+            const auto& node = nodes[order[position]];
+            Instruction instruction{node.op, node.inputs, node.constants};
+            for (auto& input: instruction.inputs) {
+                if (input != DAG_CONSTANT) input = positions[input];
+            }
+            instructions.push_back(instruction);
+
+            const long node_dependent_count = node_offsets[order[position] + 1] - node_offsets[order[position]];
+            dependent_offsets[position + 1] = dependent_offsets[position] + node_dependent_count;
+            for (long d = 0; d < node_dependent_count; ++d) {
+                dependents[dependent_offsets[position] + d] = positions[node_dependents[node_offsets[order[position]] + d]];
+            }
+        }
+
+        evaluate();
+    }
+
+    /**
+     * Recomputes every node in one pass, keeping the overridden values
+     */
+    void evaluate() {
+        values.resize(instructions.size());
+        for (long position = 0; position < (long)instructions.size(); ++position) {
+            if (!overridden[position]) values[position] = compute(position);
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const { return instructions.size(); }
+
+    [[nodiscard]] Value value(long node) const { return values[positions[node]]; }
+
+    /**
+     * Pins the node to value instead of its op and updates the nodes downstream
+     */
+    void override_value(long node, Value value) {
+        const long position = positions[node];
+        overridden[position] = true;
+        if (values[position] == value) return;
+        values[position] = value;
+        propagate(position);
+    }
+
+    /**
+     * Lets the node compute its value from its op again and updates the nodes downstream
+     */
+    void clear_override(long node) {
+        const long position = positions[node];
+        if (!overridden[position]) return;
+        overridden[position] = false;
+        Value value = compute(position);
+        if (value == values[position]) return;
+        values[position] = value;
+        propagate(position);
+    }
+};
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef AOC_DELTA_STEPPING_H
+#define AOC_DELTA_STEPPING_H
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Most buckets a worker's ring may need, delta has to be at least max_weight / DELTA_MAX_BUCKETS
+inline constexpr long DELTA_MAX_BUCKETS = 1 << 16;
+
+/**
+ * Parallel delta-stepping over any graph with size(), edges_of(node) and max_edge_weight().
+ *
+ * Nodes are kept in buckets of width delta. The nodes of the lowest bucket are split between the threads
+ * and relaxed over their light edges (weight <= delta) until the bucket stops refilling, then their heavy
+ * edges are relaxed once. Distances are lowered with a lock-free atomic min, improved nodes go to
+ * per-thread buckets, and the threads meet at a barrier whose completion step collects the next frontier.
+ * Weights must be non-negative; the distances are exactly those of Dijkstra.
+ *
+ * Like Dial's ring, the buckets are reused cyclically: a node is never more than max_weight / delta + 1
+ * buckets ahead of the current one, so that many buckets plus one are enough however long the paths get.
+ *
+ * @param delta bucket width, 0 picks the largest edge weight
+ * @throws std::logic_error if delta is so small for the weights that the ring would need more than DELTA_MAX_BUCKETS
+ * @param threads 0 uses all the hardware threads
+ * @return distance of every node from start, max long if unreachable
+ */
+template<typename AnyGraph>
+std::vector<long> delta_stepping_distances(const AnyGraph& graph, long start, long delta = 0, unsigned threads = 0) {
+    constexpr long UNREACHABLE = std::numeric_limits<long>::max();
+    if (delta <= 0) delta = std::max(1l, (long)graph.max_edge_weight());
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const long bucket_count = std::max(0l, (long)graph.max_edge_weight()) / delta + 2;
+    if (bucket_count > DELTA_MAX_BUCKETS) {
+        throw std::logic_error("Delta is too small for the edge weights, the bucket ring would not fit");
+    }
+
+    std::vector<std::atomic<long>> distances(graph.size());
+    for (auto& distance: distances) {
+        distance.store(UNREACHABLE, std::memory_order_relaxed);
+    }
+    distances[start].store(0, std::memory_order_relaxed);
+
+    typedef struct Worker {
+        // Ring of buckets, bucket b lives at b % bucket_count and is only allocated once used
+        std::vector<std::vector<long>> buckets;
+        // Nodes relaxed in the current bucket, their heavy edges are done once it is empty
+        std::vector<long> settled;
+    } Worker;
+    std::vector<Worker> workers(threads);
+    workers[0].buckets.resize(1);
+    workers[0].buckets[0].push_back(start);
+
+    typedef enum Stage {
+        STAGE_LIGHT,
+        STAGE_HEAVY,
+        STAGE_DONE,
+    } Stage;
+    Stage stage = STAGE_HEAVY;
+    long current = -1;
+    std::vector<long> frontier;
+
+    // Runs on one thread while all the others wait, so it can touch every worker's buckets
+    auto collect_frontier = [&]() {
+        frontier.clear();
+        for (auto& worker: workers) {
+            const long slot = current % bucket_count;
+            if (slot >= (long)worker.buckets.size()) continue;
+            auto& bucket = worker.buckets[slot];
+            frontier.insert(frontier.end(), bucket.begin(), bucket.end());
+            bucket.clear();
+        }
+    };
+    auto next_stage = [&]() noexcept {
+        if (stage == STAGE_LIGHT) {
+            collect_frontier();
+            if (frontier.empty()) stage = STAGE_HEAVY;
+            return;
+        }
+
+        // Everything pending is within the ring ahead of the current bucket
+        long next = UNREACHABLE;
+        for (const auto& worker: workers) {
+            for (long bucket = current + 1; bucket < current + bucket_count && bucket < next; ++bucket) {
+                const long slot = bucket % bucket_count;
+                if (slot < (long)worker.buckets.size() && !worker.buckets[slot].empty()) next = bucket;
+            }
+        }
+        if (next == UNREACHABLE) {
+            stage = STAGE_DONE;
+            return;
+        }
+        current = next;
+        collect_frontier();
+        stage = STAGE_LIGHT;
+    };
+    std::barrier sync((std::ptrdiff_t)threads, next_stage);
+
+    auto relax = [&](Worker& worker, long node, long candidate) {
+        long known = distances[node].load(std::memory_order_relaxed);
+        while (candidate < known) {
+            if (distances[node].compare_exchange_weak(known, candidate, std::memory_order_relaxed)) {
+                const auto slot = (std::size_t)(candidate / delta % bucket_count);
+                if (slot >= worker.buckets.size()) worker.buckets.resize(slot + 1);
+                worker.buckets[slot].push_back(node);
+                return;
+            }
+        }
+    };
+
+    auto work = [&](unsigned thread) {
+        auto& worker = workers[thread];
+        while (true) {
+            sync.arrive_and_wait();
+            if (stage == STAGE_DONE) return;
+
+            if (stage == STAGE_LIGHT) {
+                const std::size_t first = frontier.size() * thread / threads;
+                const std::size_t last = frontier.size() * (thread + 1) / threads;
+                for (std::size_t i = first; i < last; ++i) {
+                    const long node = frontier[i];
+                    const long distance = distances[node].load(std::memory_order_relaxed);
+                    worker.settled.push_back(node);
+                    for (const auto& edge: graph.edges_of(node)) {
+                        if ((long)edge.weight <= delta) relax(worker, (long)edge.destination, distance + (long)edge.weight);
+                    }
+                }
+            } else {
+                for (auto node: worker.settled) {
+                    const long distance = distances[node].load(std::memory_order_relaxed);
+                    for (const auto& edge: graph.edges_of(node)) {
+                        if ((long)edge.weight > delta) relax(worker, (long)edge.destination, distance + (long)edge.weight);
+                    }
+                }
+                worker.settled.clear();
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned thread = 1; thread < threads; ++thread) {
+        pool.emplace_back(work, thread);
+    }
+    work(0);
+    for (auto& thread: pool) {
+        thread.join();
+    }
+
+    std::vector<long> result(graph.size());
+    for (std::size_t node = 0; node < result.size(); ++node) {
+        result[node] = distances[node].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+#endif
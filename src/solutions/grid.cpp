@@ -1,7 +1,8 @@
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
 #include "grid.h"
 
-#include "./string_split.h"
 #include "../trim.h"
 #include "fmt/format.h"
 
@@ -47,6 +48,8 @@ GridCell GridCell::operator*(long multiplier) const {
 }
 
 
+Grid::Grid(std::size_t rows, std::size_t columns, std::string data): rows(rows), columns(columns), data(std::move(data)), stride(columns) {}
+
 [[nodiscard]]
 char Grid::at(const std::size_t& column, const std::size_t& row) const noexcept {
     if (column >= columns) {
@@ -57,7 +60,7 @@ char Grid::at(const std::size_t& column, const std::size_t& row) const noexcept
         return '\0';
     }
 
-    return data.at(column + ((columns) * row));
+    return data[(leading_rows + row) * stride + leading_columns + column];
 }
 
 [[nodiscard]]
@@ -67,25 +70,161 @@ char Grid::at(const GridCell& cell) const noexcept {
 
 [[nodiscard]]
 std::string Grid::substr(const std::size_t& column, const std::size_t& length, const std::size_t& row) const noexcept {
-    return data.substr(column + ((columns) * row), length);
+    return data.substr(storage_idx({(long)row, (long)column}), std::min(length, columns - column));
 }
 
 bool Grid::set_value(const GridCell& cell, const char& c) {
     if (this->contains(cell)) {
-        data[(cell.column + ((columns) * cell.row))] = c;
+        set_unchecked(cell, c);
         return true;
     }
     return false;
 }
 
+void Grid::enable_hashing() {
+    hashing = false;
+    hash = state_hash();
+    hashing = true;
+}
+
+uint64_t Grid::state_hash() const {
+    if (hashing) return hash;
+
+    uint64_t full_hash = 0;
+    for (long row = 0; row < rows; ++row) {
+        for (long column = 0; column < columns; ++column) {
+            full_hash ^= zobrist_key({row, column}, at_unchecked({row, column}));
+        }
+    }
+    return full_hash;
+}
+
+bool Grid::same_cells(const Grid &other) const {
+    if (rows != other.rows || columns != other.columns) return false;
+    for (long row = 0; row < rows; ++row) {
+        if (data.compare(storage_idx({row, 0}), columns, other.data, other.storage_idx({row, 0}), columns) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Mixes the cells of a freshly added row into the hash
+static void hash_row(Grid &grid, long row) {
+    if (!grid.hashing) return;
+    for (long column = 0; column < (long)grid.columns; ++column) {
+        grid.hash ^= grid.zobrist_key({row, column}, grid.at_unchecked({row, column}));
+    }
+}
+
+static void hash_column(Grid &grid, long column) {
+    if (!grid.hashing) return;
+    for (long row = 0; row < (long)grid.rows; ++row) {
+        grid.hash ^= grid.zobrist_key({row, column}, grid.at_unchecked({row, column}));
+    }
+}
+
+static std::size_t trailing_rows(const Grid &grid) {
+    if (grid.stride == 0) return 0;
+    return grid.data.size() / grid.stride - grid.leading_rows - grid.rows;
+}
+
+static std::size_t trailing_columns(const Grid &grid) {
+    return grid.stride - grid.leading_columns - grid.columns;
+}
+
+// Slack that has to stay around the grid for the sentinel halo
+static std::size_t halo(const Grid &grid) {
+    return grid.sentinel.has_value() ? 1 : 0;
+}
+
+static void fill_sentinel_border(Grid &grid) {
+    if (!grid.sentinel.has_value()) return;
+    const char c = grid.sentinel.value();
+    const auto rows = (long)grid.rows;
+    const auto columns = (long)grid.columns;
+
+    // Written directly, the halo is not part of the hash
+    for (long column = -1; column <= columns; ++column) {
+        grid.data[grid.storage_idx({-1, column})] = c;
+        grid.data[grid.storage_idx({rows, column})] = c;
+    }
+    for (long row = 0; row < rows; ++row) {
+        grid.data[grid.storage_idx({row, -1})] = c;
+        grid.data[grid.storage_idx({row, columns})] = c;
+    }
+}
+
+void Grid::reserve(std::size_t rows_before, std::size_t rows_after, std::size_t columns_before, std::size_t columns_after) {
+    rows_before = std::max(rows_before, leading_rows);
+    rows_after = std::max(rows_after, trailing_rows(*this));
+    columns_before = std::max(columns_before, leading_columns);
+    columns_after = std::max(columns_after, trailing_columns(*this));
+
+    std::size_t new_stride = columns_before + columns + columns_after;
+    std::size_t new_size = (rows_before + rows + rows_after) * new_stride;
+    if (new_stride == stride && new_size == data.size() && rows_before == leading_rows) {
+        // Already has enough slack everywhere
+        return;
+    }
+
+    std::string new_data(new_size, '\0');
+    for (std::size_t row = 0; row < rows; ++row) {
+        auto from = data.begin() + (long)storage_idx({(long)row, 0});
+        std::copy(from, from + (long)columns, new_data.begin() + (long)((rows_before + row) * new_stride + columns_before));
+    }
+
+    data = std::move(new_data);
+    stride = new_stride;
+    leading_rows = rows_before;
+    leading_columns = columns_before;
+    fill_sentinel_border(*this);
+}
+
+void Grid::set_sentinel_border(const char &c) {
+    sentinel = c;
+    reserve(1, 1, 1, 1);
+    fill_sentinel_border(*this);
+}
+
+void Grid::clear_sentinel_border() {
+    sentinel.reset();
+}
+
+void Grid::shrink_to_fit() {
+    sentinel.reset();
+    data = packed_data();
+    stride = columns;
+    leading_rows = 0;
+    leading_columns = 0;
+}
+
+std::string Grid::packed_data() const {
+    if (stride == columns && data.size() == rows * columns) {
+        return data;
+    }
+
+    std::string packed;
+    packed.reserve(rows * columns);
+    for (std::size_t row = 0; row < rows; ++row) {
+        packed.append(data, storage_idx({(long)row, 0}), columns);
+    }
+    return packed;
+}
+
 void Grid::add_row(const std::string &row) {
     auto trimmed_row = trim(row);
     if (trimmed_row.size() != columns) {
         throw std::logic_error("The inserted row must be as long as the number of columns");
     }
 
-    data.append(trimmed_row);
+    // Out of slack, double it so the growth is amortised
+    if (trailing_rows(*this) <= halo(*this)) reserve(0, std::max(rows, 1ul) + halo(*this), 0, 0);
+
+    std::copy(trimmed_row.begin(), trimmed_row.end(), data.begin() + (long)storage_idx({(long)rows, 0}));
     rows++;
+    fill_sentinel_border(*this);
+    hash_row(*this, (long)rows - 1);
 }
 
 void Grid::add_row(const char &character) {
@@ -99,16 +238,14 @@ void Grid::add_column(const std::string &column) {
         throw std::logic_error("The inserted column must be as long as the number of rows");
     }
 
-    uint row_idx = 0;
-    for (char column_idx : trimmed_column) {
-        if (row_idx >= (this->rows - 1)) {
-            data.insert(data.end(), column_idx);
-        } else {
-            data.insert(columns + (columns * row_idx) + row_idx, 1, column_idx);
-        }
-        row_idx++;
+    if (trailing_columns(*this) <= halo(*this)) reserve(0, 0, 0, std::max(columns, 1ul) + halo(*this));
+
+    for (std::size_t row_idx = 0; row_idx < rows; ++row_idx) {
+        data[storage_idx({(long)row_idx, (long)columns})] = trimmed_column[row_idx];
     }
     columns++;
+    fill_sentinel_border(*this);
+    hash_column(*this, (long)columns - 1);
 }
 
 void Grid::add_column(const char &character) {
@@ -122,8 +259,19 @@ void Grid::add_row_start(const std::string &row) {
         throw std::logic_error("The inserted row must be as long as the number of columns");
     }
 
-    data.insert(0, trimmed_row);
+    if (leading_rows <= halo(*this)) reserve(std::max(rows, 1ul) + halo(*this), 0, 0, 0);
+
+    leading_rows--;
     rows++;
+    origin.row++;
+    std::copy(trimmed_row.begin(), trimmed_row.end(), data.begin() + (long)storage_idx({0, 0}));
+    fill_sentinel_border(*this);
+    hash_row(*this, 0);
+}
+
+void Grid::add_row_start(const char &character) {
+    std::string new_row(this->columns, character);
+    this->add_row_start(new_row);
 }
 
 void Grid::add_column_start(const std::string &column) {
@@ -132,12 +280,21 @@ void Grid::add_column_start(const std::string &column) {
         throw std::logic_error("The inserted column must be as long as the number of rows");
     }
 
-    uint row_idx = 0;
-    for (char column_idx : trimmed_column) {
-        data.insert(0 + ((columns + row_idx) * row_idx), 1, column_idx);
-        row_idx++;
-    }
+    if (leading_columns <= halo(*this)) reserve(0, 0, std::max(columns, 1ul) + halo(*this), 0);
+
+    leading_columns--;
     columns++;
+    origin.column++;
+    for (std::size_t row_idx = 0; row_idx < rows; ++row_idx) {
+        data[storage_idx({(long)row_idx, 0})] = trimmed_column[row_idx];
+    }
+    fill_sentinel_border(*this);
+    hash_column(*this, 0);
+}
+
+void Grid::add_column_start(const char &character) {
+    std::string new_column(this->rows, character);
+    this->add_column_start(new_column);
 }
 
 void Grid::rotate_cw() {
@@ -146,10 +303,9 @@ void Grid::rotate_cw() {
 
     // Create 2 dimensional vector
     std::vector<std::vector<char>> split_grid(rows, std::vector<char>(columns));
-    int idx = 0;
     for (int r = 0; r < rows; r++) {
         for (int c = 0; c < columns; c++) {
-            split_grid[r][c] = data[idx++];
+            split_grid[r][c] = at(c, r);
         }
     }
 
@@ -173,6 +329,12 @@ void Grid::rotate_cw() {
     auto tmp = columns;
     columns = rows;
     rows = tmp;
+    stride = columns;
+    leading_rows = 0;
+    leading_columns = 0;
+    if (sentinel.has_value()) set_sentinel_border(sentinel.value());
+    // Every cell moved, nothing to update incrementally
+    if (hashing) enable_hashing();
 }
 
 bool Grid::contains(const GridCell &cell) const {
@@ -187,34 +349,136 @@ GridCell Grid::underlying_idx_to_cell(ulong idx) const {
     return GridCell{(long)idx / ((long)columns), (long)idx % (long)columns};
 }
 
+ulong Grid::storage_idx(const GridCell &cell) const {
+    return (leading_rows + cell.row) * stride + leading_columns + cell.column;
+}
+
 GridCell Grid::find_first(const char &c) const {
     for (long row = 0; row < rows; ++row) {
-        for (long column = 0; column < columns; ++column) {
-            if (at(column, row) == c) return GridCell{row, column};
-        }
+        const char *row_start = data.data() + storage_idx({row, 0});
+        const auto *found = static_cast<const char *>(std::memchr(row_start, c, columns));
+        if (found != nullptr) return GridCell{row, found - row_start};
     }
     throw std::out_of_range("character not found");
 }
 
-Grid make_grid(const std::string &in) {
-    std::string trimmed = trim(in);
-    auto lines = string_split(trimmed, '\n');
-    if (lines.empty()) {
+std::vector<GridCell> Grid::find_all(const char &c) const {
+    std::vector<GridCell> found_cells;
+    for (long row = 0; row < rows; ++row) {
+        const char *row_start = data.data() + storage_idx({row, 0});
+        const char *row_end = row_start + columns;
+        const char *from = row_start;
+        while (from < row_end) {
+            const auto *found = static_cast<const char *>(std::memchr(from, c, row_end - from));
+            if (found == nullptr) break;
+            found_cells.push_back(GridCell{row, found - row_start});
+            from = found + 1;
+        }
+    }
+    return found_cells;
+}
+
+typedef struct GridLines {
+    std::size_t rows;
+    std::size_t columns;
+    // Length of the line ending, 0 if the grid has just one row
+    std::size_t separator;
+    // Whether all the lines end the same way, so line starts are evenly spaced
+    bool uniform_separator;
+    const char *begin;
+} GridLines;
+
+// Walks the lines of the grid in a single pass, checking they are all equally long
+template<typename OnLine>
+static GridLines scan_grid_lines(std::string_view in, OnLine on_line) {
+    constexpr const char *whitespace = " \t\r\n";
+    auto first = in.find_first_not_of(whitespace);
+    if (first == std::string_view::npos) {
         throw std::logic_error("Grid must have at least 1 row");
     }
-    ulong rows = lines.size();
-    ulong columns = lines.at(0).size();
+    in = in.substr(first, in.find_last_not_of(whitespace) - first + 1);
+
+    GridLines lines{0, 0, 0, true, in.data()};
+    const char *cursor = in.data();
+    const char *end = in.data() + in.size();
+    while (cursor < end) {
+        // memchr is vectorised by the libc
+        const auto *newline = static_cast<const char *>(std::memchr(cursor, '\n', end - cursor));
+        const char *line_end = newline == nullptr ? end : newline;
+        std::size_t separator = newline == nullptr ? 0 : 1;
+        if (line_end > cursor && *(line_end - 1) == '\r') {
+            line_end--;
+            separator++;
+        }
 
-    trimmed.erase(std::remove_if(trimmed.begin(), trimmed.end(), [](const char& c) {
-        return c == '\n';
-    }), trimmed.end());
-    
-    return Grid{rows, columns, trimmed};
+        auto width = (std::size_t)(line_end - cursor);
+        if (lines.rows == 0) {
+            lines.columns = width;
+            lines.separator = separator;
+        } else if (width != lines.columns) {
+            throw std::logic_error("All rows of the grid must be of the same length");
+        }
+        if (newline != nullptr && separator != lines.separator) {
+            lines.uniform_separator = false;
+        }
+
+        on_line(std::string_view(cursor, width));
+        lines.rows++;
+        cursor = newline == nullptr ? end : newline + 1;
+    }
+
+    return lines;
+}
+
+Grid make_grid(const std::string &in) {
+    std::string data;
+    data.reserve(in.size());
+    auto lines = scan_grid_lines(in, [&data](std::string_view line) {
+        data.append(line);
+    });
+
+    return Grid{lines.rows, lines.columns, std::move(data)};
+}
+
+GridView make_grid_view(std::string_view in) {
+    auto lines = scan_grid_lines(in, [](std::string_view) {});
+    if (!lines.uniform_separator) {
+        throw std::logic_error("All rows of the grid view must end the same way");
+    }
+
+    return GridView{lines.rows, lines.columns, lines.columns + lines.separator, lines.begin};
+}
+
+Grid GridView::to_grid() const {
+    std::string packed;
+    packed.reserve(rows * columns);
+    for (std::size_t row = 0; row < rows; ++row) {
+        packed.append(data + row * stride, columns);
+    }
+    return Grid{rows, columns, std::move(packed)};
+}
+
+char GridView::at(const GridCell &cell) const noexcept {
+    if (!contains(cell)) return '\0';
+    return at_unchecked(cell);
+}
+
+bool GridView::contains(const GridCell &cell) const {
+    return (0 <= cell.row && cell.row < (long)rows) && (0 <= cell.column && cell.column < (long)columns);
+}
+
+GridCell GridView::find_first(const char &c) const {
+    for (long row = 0; row < rows; ++row) {
+        const char *row_start = data + row * stride;
+        const auto *found = static_cast<const char *>(std::memchr(row_start, c, columns));
+        if (found != nullptr) return GridCell{row, found - row_start};
+    }
+    throw std::out_of_range("character not found");
 }
 
 void draw_grid(const Grid &grid) {
     for (std::size_t row = 0; row < grid.rows; row++) {
-        fmt::println("{}", grid.data.substr(0 + (row * grid.columns), grid.columns));
+        fmt::println("{}", grid.substr(0, grid.columns, row));
     }
     fmt::println("------------------------------------");
 }
@@ -222,7 +486,7 @@ void draw_grid(const Grid &grid) {
 std::string draw_grid_to_string(const Grid& grid) {
     std::string str;
     for (std::size_t row = 0; row < grid.rows; row++) {
-        str += fmt::format("{}\n", grid.data.substr(0 + (row * grid.columns), grid.columns));
+        str += fmt::format("{}\n", grid.substr(0, grid.columns, row));
     }
     return str;
 }
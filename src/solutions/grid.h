@@ -1,7 +1,12 @@
 #ifndef AOC_GRID_H
 #define AOC_GRID_H
 
+#include <array>
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 typedef struct GridCell {
     long row;
@@ -21,16 +26,65 @@ typedef struct GridCell {
 } GridCell;
 
 typedef struct Grid {
-    std::size_t rows;
-    std::size_t columns;
+    std::size_t rows = 0;
+    std::size_t columns = 0;
     std::string data;
 
+    /*
+     * Capacity model - each row takes `stride` characters of `data` and the grid starts at
+     * `leading_rows`/`leading_columns` inside of it. The rest is slack, so growing the grid
+     * at any edge only writes the new cells until the slack runs out and the storage doubles.
+     */
+    std::size_t stride = 0;
+    std::size_t leading_rows = 0;
+    std::size_t leading_columns = 0;
+
+    /*
+     * Number of rows and columns prepended since construction. A cell taken before growing
+     * the grid stays valid as `cell + (origin - origin_back_then)`.
+     */
+    GridCell origin{0, 0};
+
+    /*
+     * When set, a one cell halo around the grid is kept filled with this character,
+     * so neighbours of any cell can be read with at_unchecked() without bounds tests.
+     */
+    std::optional<char> sentinel;
+
+    /*
+     * Optional incremental Zobrist hash of the cells. Once enabled, every write through
+     * set_value/set_unchecked and every growth keeps `hash` up to date, so the state of the grid
+     * can be used as a 64-bit key. Cells are keyed by their position relative to `origin`, so growing
+     * only mixes in the new cells. Equal grids with the same origin hash the same, but different
+     * grids may collide, use same_cells() to confirm a match.
+     */
+    bool hashing = false;
+    uint64_t hash = 0;
+
+    Grid() = default;
+    Grid(std::size_t rows, std::size_t columns, std::string data);
+
     [[nodiscard]]
     char at(const std::size_t& column, const std::size_t& row) const noexcept;
 
     [[nodiscard]]
     char at(const GridCell&) const noexcept;
 
+    /**
+     * Same as at() but without any bounds checking, the cell must be inside the grid
+     * or, with a sentinel border, at most one cell outside of it.
+     */
+    [[nodiscard]]
+    char at_unchecked(const GridCell& cell) const noexcept {
+        return data[(leading_rows + cell.row) * stride + leading_columns + cell.column];
+    }
+
+    void set_unchecked(const GridCell& cell, const char& c) noexcept {
+        char &slot = data[(leading_rows + cell.row) * stride + leading_columns + cell.column];
+        if (hashing) hash ^= zobrist_key(cell, slot) ^ zobrist_key(cell, c);
+        slot = c;
+    }
+
     /**
      * Sets value of cell
      *
@@ -52,18 +106,209 @@ typedef struct Grid {
     void add_column(const char &character);
 
     void add_row_start(const std::string &row);
+    void add_row_start(const char &character);
+
     void add_column_start(const std::string &row);
+    void add_column_start(const char &character);
+
+    /**
+     * Makes sure there is at least the requested slack around the grid, relayouting the storage if needed
+     */
+    void reserve(std::size_t rows_before, std::size_t rows_after, std::size_t columns_before, std::size_t columns_after);
+
+    /**
+     * Drops all the slack and the sentinel border, afterwards `data` is again plain row-major
+     */
+    void shrink_to_fit();
+
+    /**
+     * @return the row-major cells without any slack
+     */
+    [[nodiscard]] std::string packed_data() const;
 
     void rotate_cw();
 
+    /**
+     * Surrounds the grid with a one cell halo of c, kept up to date as the grid grows
+     */
+    void set_sentinel_border(const char &c);
+    void clear_sentinel_border();
+
+    void enable_hashing();
+
+    /**
+     * @return Zobrist hash of the cells, computed from scratch when hashing is not enabled
+     */
+    [[nodiscard]] uint64_t state_hash() const;
+
+    /**
+     * Full comparison of the cells, for when two state hashes match
+     */
+    [[nodiscard]] bool same_cells(const Grid& other) const;
+
+    /**
+     * Pseudo-random key of character c at cell, mixed on the fly instead of stored in a table.
+     * Row and column are taken relative to `origin`, so the key does not depend on the grid size.
+     */
+    [[nodiscard]] uint64_t zobrist_key(const GridCell& cell, char c) const noexcept {
+        auto mix = [](uint64_t key) {
+            key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ull;
+            key = (key ^ (key >> 27)) * 0x94d049bb133111ebull;
+            return key ^ (key >> 31);
+        };
+        uint64_t position = ((uint64_t)(uint32_t)(cell.row - origin.row) << 32)
+                | (uint32_t)(cell.column - origin.column);
+        return mix(mix(position) + (uint8_t)c);
+    }
+
     [[nodiscard]] GridCell find_first(const char &c) const;
+    [[nodiscard]] std::vector<GridCell> find_all(const char &c) const;
 
+    /**
+     * Row-major index of the cell as if the grid had no slack, handy as a node id
+     */
     [[nodiscard]] ulong underlying_idx(const GridCell& cell) const;
     [[nodiscard]] GridCell underlying_idx_to_cell(ulong idx) const;
+
+    /**
+     * Index of the cell inside `data`
+     */
+    [[nodiscard]] ulong storage_idx(const GridCell& cell) const;
 } Grid;
 
+/*
+ * Read-only grid over somebody else's buffer, usually the puzzle input itself.
+ * Rows are `stride` apart to skip the line endings, so nothing gets copied.
+ * The buffer must outlive the view.
+ */
+typedef struct GridView {
+    std::size_t rows;
+    std::size_t columns;
+    std::size_t stride;
+    const char *data;
+
+    [[nodiscard]] char at(const GridCell& cell) const noexcept;
+
+    [[nodiscard]]
+    char at_unchecked(const GridCell& cell) const noexcept {
+        return data[cell.row * stride + cell.column];
+    }
+
+    [[nodiscard]] bool contains(const GridCell& cell) const;
+    [[nodiscard]] GridCell find_first(const char &c) const;
+    [[nodiscard]] Grid to_grid() const;
+} GridView;
+
+/**
+ * Builds the grid in a single pass over the input, surrounding whitespace is ignored
+ * and both LF and CRLF line endings are accepted
+ *
+ * @throws std::logic_error if the rows are not all of the same length
+ */
 Grid make_grid(const std::string &in);
+
+/**
+ * Same as make_grid, but the grid just points into the input
+ */
+GridView make_grid_view(std::string_view in);
 Grid make_grid(std::size_t rows, std::size_t columns, char fill_char);
+// Neighbour offsets, clockwise from north
+inline constexpr std::array<GridCell, 4> NEIGHBOURS_4 = {
+        GridCell{-1,  0},
+        GridCell{ 0, +1},
+        GridCell{+1,  0},
+        GridCell{ 0, -1},
+};
+
+inline constexpr std::array<GridCell, 8> NEIGHBOURS_8 = {
+        GridCell{-1,  0},
+        GridCell{-1, +1},
+        GridCell{ 0, +1},
+        GridCell{+1, +1},
+        GridCell{+1,  0},
+        GridCell{+1, -1},
+        GridCell{ 0, -1},
+        GridCell{-1, -1},
+};
+
+/**
+ * Calls fn(neighbour, value) for every orthogonal neighbour of cell that is inside the grid
+ */
+template<typename Fn>
+void for_each_neighbour_4(const Grid& grid, const GridCell& cell, Fn fn) {
+    for (const auto& offset: NEIGHBOURS_4) {
+        auto neighbour = cell + offset;
+        if (grid.contains(neighbour)) fn(neighbour, grid.at_unchecked(neighbour));
+    }
+}
+
+/**
+ * Calls fn(neighbour, value) for every neighbour of cell, diagonals included, that is inside the grid
+ */
+template<typename Fn>
+void for_each_neighbour_8(const Grid& grid, const GridCell& cell, Fn fn) {
+    for (const auto& offset: NEIGHBOURS_8) {
+        auto neighbour = cell + offset;
+        if (grid.contains(neighbour)) fn(neighbour, grid.at_unchecked(neighbour));
+    }
+}
+
+typedef struct Neighbourhood {
+    char north_west, north, north_east;
+    char west, centre, east;
+    char south_west, south, south_east;
+} Neighbourhood;
+
+/**
+ * Computes a new grid of the same size where every cell is kernel(neighbourhood of the cell).
+ * Cells outside of the grid read as `outside`. The border is handled separately, so the loop
+ * over the interior is branch-free and the compiler can vectorise simple kernels.
+ */
+template<typename Kernel>
+Grid apply_stencil(const Grid& grid, Kernel kernel, char outside = '\0') {
+    Grid output{grid.rows, grid.columns, std::string(grid.rows * grid.columns, outside)};
+    if (grid.rows == 0 || grid.columns == 0) return output;
+    const auto rows = (long)grid.rows;
+    const auto columns = (long)grid.columns;
+
+    auto value = [&grid, &outside](long row, long column) {
+        return grid.contains({row, column}) ? grid.at_unchecked({row, column}) : outside;
+    };
+    auto border_cell = [&](long row, long column) {
+        output.set_unchecked({row, column}, kernel(Neighbourhood{
+                value(row - 1, column - 1), value(row - 1, column), value(row - 1, column + 1),
+                value(row, column - 1), value(row, column), value(row, column + 1),
+                value(row + 1, column - 1), value(row + 1, column), value(row + 1, column + 1),
+        }));
+    };
+
+    for (long column = 0; column < columns; ++column) {
+        border_cell(0, column);
+        if (rows > 1) border_cell(rows - 1, column);
+    }
+    for (long row = 1; row < rows - 1; ++row) {
+        border_cell(row, 0);
+        if (columns > 1) border_cell(row, columns - 1);
+    }
+
+    for (long row = 1; row < rows - 1; ++row) {
+        const char *above = grid.data.data() + grid.storage_idx({row - 1, 0});
+        const char *current = grid.data.data() + grid.storage_idx({row, 0});
+        const char *below = grid.data.data() + grid.storage_idx({row + 1, 0});
+        char *out = output.data.data() + output.storage_idx({row, 0});
+
+        for (long column = 1; column < columns - 1; ++column) {
+            out[column] = kernel(Neighbourhood{
+                    above[column - 1], above[column], above[column + 1],
+                    current[column - 1], current[column], current[column + 1],
+                    below[column - 1], below[column], below[column + 1],
+            });
+        }
+    }
+
+    return output;
+}
+
 void draw_grid(const Grid& grid);
 std::string draw_grid_to_string(const Grid& grid);
 
@@ -0,0 +1,73 @@
+#ifndef AOC_GRID_GRAPH_H
+#define AOC_GRID_GRAPH_H
+
+#include <array>
+#include <optional>
+#include "grid.h"
+#include "Graph.h"
+
+/*
+ * Up to four edges of one grid cell, built on the stack by GridGraph::edges_of
+ */
+typedef struct GridEdges {
+    std::array<Edge, 4> edges;
+    std::size_t count = 0;
+
+    [[nodiscard]] const Edge* begin() const { return edges.data(); }
+    [[nodiscard]] const Edge* end() const { return edges.data() + count; }
+    [[nodiscard]] std::size_t size() const { return count; }
+} GridEdges;
+
+/*
+ * Graph over the cells of a grid whose edges are never stored. Nodes are Grid::underlying_idx of the cells,
+ * and the edges to the 4 neighbours come from weight(from_value, to_value) at search time, where an empty
+ * optional means there is no edge. Works with every search of Graph.h. The grid must outlive the graph.
+ */
+template<typename Weight>
+class GridGraph {
+    const Grid *grid;
+    Weight weight;
+    std::size_t edge_total = 0;
+    long min_weight = 0;
+    long max_weight = 0;
+
+public:
+    GridGraph(const Grid& grid, Weight weight): grid(&grid), weight(weight) {
+        // One pass for the weight range the searches dispatch on, nothing is kept
+        for (long node = 0; node < size(); ++node) {
+            for (const auto& edge: edges_of(node)) {
+                min_weight = edge_total == 0 ? edge.weight : std::min(min_weight, edge.weight);
+                max_weight = edge_total == 0 ? edge.weight : std::max(max_weight, edge.weight);
+                edge_total++;
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const { return grid->rows * grid->columns; }
+    [[nodiscard]] std::size_t edge_count() const { return edge_total; }
+    [[nodiscard]] long min_edge_weight() const { return min_weight; }
+    [[nodiscard]] long max_edge_weight() const { return max_weight; }
+
+    [[nodiscard]] GridEdges edges_of(long node) const {
+        GridEdges result;
+        const auto cell = grid->underlying_idx_to_cell(node);
+        const char value = grid->at_unchecked(cell);
+        for (const auto& offset: NEIGHBOURS_4) {
+            const auto next = cell + offset;
+            if (!grid->contains(next)) continue;
+            std::optional<long> edge_weight = weight(value, grid->at_unchecked(next));
+            if (edge_weight.has_value()) result.edges[result.count++] = Edge{edge_weight.value(), (long)grid->underlying_idx(next)};
+        }
+        return result;
+    }
+
+    /**
+     * @return the same grid graph with every edge pointing the other way
+     */
+    [[nodiscard]] auto reversed() const {
+        auto reversed_weight = [weight = weight](char from, char to) { return weight(to, from); };
+        return GridGraph<decltype(reversed_weight)>(*grid, reversed_weight);
+    }
+};
+
+#endif
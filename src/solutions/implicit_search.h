@@ -0,0 +1,104 @@
+#ifndef AOC_IMPLICIT_SEARCH_H
+#define AOC_IMPLICIT_SEARCH_H
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Best known costs of the states seen by a search. Bounded state spaces get a dense array indexed
+ * by the state key, unbounded ones (state_count == 0) fall back to a hash map.
+ */
+class StateCosts {
+    std::vector<long> dense;
+    std::unordered_map<uint64_t, long> sparse;
+    bool is_dense;
+
+public:
+    explicit StateCosts(std::size_t state_count):
+        dense(state_count, std::numeric_limits<long>::max()),
+        is_dense(state_count > 0) {}
+
+    [[nodiscard]] long get(uint64_t key) const {
+        if (is_dense) return dense[key];
+        auto found = sparse.find(key);
+        return found == sparse.end() ? std::numeric_limits<long>::max() : found->second;
+    }
+
+    void set(uint64_t key, long cost) {
+        if (is_dense) dense[key] = cost;
+        else sparse[key] = cost;
+    }
+};
+
+// Heuristic of plain Dijkstra
+typedef struct NoHeuristic {
+    template<typename State>
+    long operator()(const State&) const { return 0; }
+} NoHeuristic;
+
+template<typename State>
+struct ImplicitSearchResult {
+    long cost;
+    State goal;
+};
+
+/**
+ * A* over a graph that only exists as a successor function, so states like (cell, direction, run)
+ * never have to be materialised as nodes. With NoHeuristic this is plain Dijkstra.
+ *
+ * @param state_count number of distinct keys when the state space is bounded, 0 if it is not
+ * @param key maps a state to a unique uint64_t, below state_count when that is given
+ * @param successors called as successors(state, emit), where emit(next_state, step_cost) with step_cost >= 0
+ * @param is_goal called as is_goal(state)
+ * @param heuristic lower bound of the remaining cost, it must never overestimate
+ * @return cost of the cheapest path from any start to a goal, and the goal reached
+ */
+template<typename State, typename Key, typename Successors, typename IsGoal, typename Heuristic = NoHeuristic>
+std::optional<ImplicitSearchResult<State>> implicit_search(
+        const std::vector<State>& starts,
+        std::size_t state_count,
+        Key key,
+        Successors successors,
+        IsGoal is_goal,
+        Heuristic heuristic = {}
+) {
+    typedef struct Entry {
+        long priority;
+        long cost;
+        State state;
+
+        bool operator>(const Entry& other) const { return priority > other.priority; }
+    } Entry;
+
+    StateCosts costs(state_count);
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+    for (const auto& start: starts) {
+        costs.set(key(start), 0);
+        open.push(Entry{heuristic(start), 0, start});
+    }
+
+    while (!open.empty()) {
+        auto entry = open.top();
+        open.pop();
+        if (entry.cost > costs.get(key(entry.state))) continue;
+        if (is_goal(entry.state)) return ImplicitSearchResult<State>{entry.cost, entry.state};
+
+        successors(entry.state, [&](const State& next, long step_cost) {
+            const long cost = entry.cost + step_cost;
+            const uint64_t next_key = key(next);
+            if (cost < costs.get(next_key)) {
+                costs.set(next_key, cost);
+                open.push(Entry{cost + heuristic(next), cost, next});
+            }
+        });
+    }
+
+    return std::nullopt;
+}
+
+#endif
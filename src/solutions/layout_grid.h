@@ -0,0 +1,144 @@
+#ifndef AOC_LAYOUT_GRID_H
+#define AOC_LAYOUT_GRID_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <string>
+#include "grid.h"
+
+/*
+ * Storage layouts for LayoutGrid. Each maps a cell to its index in the storage and knows
+ * how many chars the storage needs, padding included.
+ */
+
+// Plain row-major order, the same as Grid
+typedef struct RowMajorLayout {
+    std::size_t rows;
+    std::size_t columns;
+
+    RowMajorLayout(std::size_t rows, std::size_t columns): rows(rows), columns(columns) {}
+
+    [[nodiscard]] std::size_t size() const { return rows * columns; }
+
+    [[nodiscard]] std::size_t index(const GridCell& cell) const noexcept {
+        return cell.row * columns + cell.column;
+    }
+} RowMajorLayout;
+
+// 8 x 8 tiles of one cache line each, row-major inside and between the tiles
+typedef struct TiledLayout {
+    static constexpr std::size_t SHIFT = 3;
+    static constexpr std::size_t SIZE = 1 << SHIFT;
+    static constexpr std::size_t MASK = SIZE - 1;
+
+    std::size_t tile_rows;
+    std::size_t tile_columns;
+
+    TiledLayout(std::size_t rows, std::size_t columns):
+        tile_rows((rows + MASK) >> SHIFT),
+        tile_columns((columns + MASK) >> SHIFT) {}
+
+    [[nodiscard]] std::size_t size() const { return tile_rows * tile_columns * SIZE * SIZE; }
+
+    [[nodiscard]] std::size_t index(const GridCell& cell) const noexcept {
+        const std::size_t tile = (cell.row >> SHIFT) * tile_columns + (cell.column >> SHIFT);
+        return (tile << (2 * SHIFT)) | ((cell.row & MASK) << SHIFT) | (cell.column & MASK);
+    }
+} TiledLayout;
+
+/*
+ * Z-order curve, the bits of row and column interleaved. Nearby cells stay nearby in every
+ * direction at every scale, but the grid is padded to a power of two square.
+ */
+typedef struct MortonLayout {
+    std::size_t side;
+
+    MortonLayout(std::size_t rows, std::size_t columns): side(std::bit_ceil(std::max({rows, columns, (std::size_t)1}))) {}
+
+    [[nodiscard]] std::size_t size() const { return side * side; }
+
+    // Moves the low 32 bits of value to the even bit positions
+    static constexpr uint64_t spread_bits(uint64_t value) {
+        value &= 0xffffffffull;
+        value = (value | (value << 16)) & 0x0000ffff0000ffffull;
+        value = (value | (value << 8)) & 0x00ff00ff00ff00ffull;
+        value = (value | (value << 4)) & 0x0f0f0f0f0f0f0f0full;
+        value = (value | (value << 2)) & 0x3333333333333333ull;
+        value = (value | (value << 1)) & 0x5555555555555555ull;
+        return value;
+    }
+
+    [[nodiscard]] std::size_t index(const GridCell& cell) const noexcept {
+        return (spread_bits(cell.row) << 1) | spread_bits(cell.column);
+    }
+} MortonLayout;
+
+/*
+ * Fixed size grid with the cell accessors of Grid over a chosen storage layout, so the templated
+ * algorithms (tilt, flood_fill, ...) run on it unchanged. Vertical walks touch far fewer cache
+ * lines in the tiled and Morton layouts, at the price of a little index arithmetic.
+ */
+template<typename Layout>
+class LayoutGrid {
+    Layout layout;
+    std::string data;
+
+public:
+    typedef Layout layout_type;
+
+    std::size_t rows;
+    std::size_t columns;
+
+    LayoutGrid(std::size_t rows, std::size_t columns, char fill_char):
+        layout(rows, columns),
+        data(layout.size(), fill_char),
+        rows(rows),
+        columns(columns) {}
+
+    [[nodiscard]] bool contains(const GridCell& cell) const {
+        return 0 <= cell.row && cell.row < rows && 0 <= cell.column && cell.column < columns;
+    }
+
+    /**
+     * @return the cell, '\0' outside of the grid
+     */
+    [[nodiscard]] char at(const GridCell& cell) const noexcept {
+        return contains(cell) ? at_unchecked(cell) : '\0';
+    }
+
+    [[nodiscard]]
+    char at_unchecked(const GridCell& cell) const noexcept {
+        return data[layout.index(cell)];
+    }
+
+    void set_unchecked(const GridCell& cell, const char& c) noexcept {
+        data[layout.index(cell)] = c;
+    }
+
+    [[nodiscard]] Grid to_grid() const {
+        auto grid = make_grid(rows, columns, '\0');
+        for (long row = 0; row < rows; ++row) {
+            for (long column = 0; column < columns; ++column) {
+                grid.set_unchecked({row, column}, at_unchecked({row, column}));
+            }
+        }
+        return grid;
+    }
+};
+
+/**
+ * Copies the cells of grid into the given layout
+ */
+template<typename Layout>
+LayoutGrid<Layout> make_layout_grid(const Grid& grid) {
+    LayoutGrid<Layout> result(grid.rows, grid.columns, '\0');
+    for (long row = 0; row < grid.rows; ++row) {
+        for (long column = 0; column < grid.columns; ++column) {
+            result.set_unchecked({row, column}, grid.at_unchecked({row, column}));
+        }
+    }
+    return result;
+}
+
+#endif
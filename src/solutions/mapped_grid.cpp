@@ -0,0 +1,185 @@
+#include "mapped_grid.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+
+static std::size_t tiles_for(std::size_t cells) {
+    return (cells + MappedGrid::TILE - 1) / MappedGrid::TILE;
+}
+
+static std::size_t bytes_for(std::size_t rows, std::size_t columns) {
+    return tiles_for(rows) * tiles_for(columns) * MappedGrid::TILE * MappedGrid::TILE;
+}
+
+MappedGrid::MappedGrid(int fd, std::size_t rows, std::size_t columns):
+    fd(fd),
+    mapped_bytes(bytes_for(rows, columns)),
+    tile_columns(tiles_for(columns)),
+    rows(rows),
+    columns(columns) {
+    if (mapped_bytes == 0) return;
+
+    void *mapping = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        int error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), "Cannot map the grid file");
+    }
+    cells = static_cast<char *>(mapping);
+}
+
+MappedGrid::MappedGrid(MappedGrid &&other) noexcept:
+    fd(std::exchange(other.fd, -1)),
+    cells(std::exchange(other.cells, nullptr)),
+    mapped_bytes(std::exchange(other.mapped_bytes, 0)),
+    tile_columns(other.tile_columns),
+    rows(std::exchange(other.rows, 0)),
+    columns(std::exchange(other.columns, 0)) {}
+
+MappedGrid &MappedGrid::operator=(MappedGrid &&other) noexcept {
+    // The old mapping goes away with other
+    std::swap(fd, other.fd);
+    std::swap(cells, other.cells);
+    std::swap(mapped_bytes, other.mapped_bytes);
+    std::swap(tile_columns, other.tile_columns);
+    std::swap(rows, other.rows);
+    std::swap(columns, other.columns);
+    return *this;
+}
+
+MappedGrid::~MappedGrid() {
+    if (cells != nullptr) munmap(cells, mapped_bytes);
+    if (fd >= 0) close(fd);
+}
+
+std::pair<std::size_t, std::size_t> MappedGrid::band_bytes(std::size_t first_row, std::size_t last_row) const {
+    const std::size_t band_size = tile_columns * TILE * TILE;
+    const auto page_size = (std::size_t)sysconf(_SC_PAGESIZE);
+
+    // madvise wants a page aligned start, tiles are only aligned to 4 KiB
+    std::size_t from = (first_row / TILE) * band_size / page_size * page_size;
+    std::size_t to = std::min(mapped_bytes, tiles_for(last_row) * band_size);
+    return {from, to};
+}
+
+char MappedGrid::at(const GridCell &cell) const noexcept {
+    if (!contains(cell)) return '\0';
+    return at_unchecked(cell);
+}
+
+bool MappedGrid::contains(const GridCell &cell) const {
+    return 0 <= cell.row && cell.row < rows && 0 <= cell.column && cell.column < columns;
+}
+
+void MappedGrid::advise_rows(std::size_t first_row, std::size_t last_row, Advice advice) {
+    auto [from, to] = band_bytes(first_row, std::min(last_row, rows));
+    if (from >= to) return;
+
+    // Hints only, the grid stays correct whether the kernel follows them or not
+    switch (advice) {
+        case ADVICE_WILL_NEED:
+            madvise(cells + from, to - from, MADV_WILLNEED);
+            break;
+        case ADVICE_DONE:
+            // Shared file pages are written back, not lost, when they are dropped
+            madvise(cells + from, to - from, MADV_DONTNEED);
+            break;
+    }
+}
+
+void MappedGrid::sync() {
+    if (cells != nullptr && msync(cells, mapped_bytes, MS_SYNC) != 0) {
+        throw std::system_error(errno, std::generic_category(), "Cannot sync the grid file");
+    }
+}
+
+MappedGrid make_mapped_grid(const std::string &path, std::size_t rows, std::size_t columns, char fill_char) {
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "Cannot create " + path);
+    if (ftruncate(fd, (off_t)bytes_for(rows, columns)) != 0) {
+        int error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), "Cannot size " + path);
+    }
+
+    MappedGrid grid(fd, rows, columns);
+    for (std::size_t row = 0; row < rows; row += MappedGrid::TILE) {
+        auto [from, to] = grid.band_bytes(row, row + MappedGrid::TILE);
+        std::memset(grid.cells + from, fill_char, to - from);
+        grid.advise_rows(row, row + MappedGrid::TILE, MappedGrid::ADVICE_DONE);
+    }
+    return grid;
+}
+
+MappedGrid open_mapped_grid(const std::string &path, std::size_t rows, std::size_t columns) {
+    int fd = ::open(path.c_str(), O_RDWR);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+
+    struct stat file_stat{};
+    if (fstat(fd, &file_stat) != 0 || (std::size_t)file_stat.st_size != bytes_for(rows, columns)) {
+        close(fd);
+        throw std::logic_error("Grid file does not match the dimensions");
+    }
+    return {fd, rows, columns};
+}
+
+static void strip_carriage_return(std::string &line) {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+}
+
+MappedGrid make_mapped_grid(const std::string &in_path, const std::string &path) {
+    // 1. Measure the grid, only one line is held at a time
+    std::ifstream measure(in_path);
+    if (!measure) throw std::system_error(errno, std::generic_category(), "Cannot read " + in_path);
+
+    std::size_t rows = 0;
+    std::size_t columns = 0;
+    std::string line;
+    while (std::getline(measure, line)) {
+        strip_carriage_return(line);
+        if (line.empty()) continue;
+        if (rows == 0) columns = line.size();
+        if (line.size() != columns) throw std::logic_error("All rows of the grid must be of the same length");
+        rows++;
+    }
+
+    // 2. Copy it over band by band, letting go of every band once it is written
+    auto grid = make_mapped_grid(path, rows, columns, '\0');
+    std::ifstream in(in_path);
+    std::size_t row = 0;
+    while (std::getline(in, line)) {
+        strip_carriage_return(line);
+        if (line.empty()) continue;
+        for (std::size_t column = 0; column < columns; ++column) {
+            grid.set_unchecked({(long)row, (long)column}, line[column]);
+        }
+        row++;
+        if (row % MappedGrid::TILE == 0) grid.advise_rows(row - MappedGrid::TILE, row, MappedGrid::ADVICE_DONE);
+    }
+    return grid;
+}
+
+void write_mapped_grid(MappedGrid &grid, const std::string &out_path) {
+    std::ofstream out(out_path);
+    if (!out) throw std::system_error(errno, std::generic_category(), "Cannot write " + out_path);
+
+    std::string line(grid.columns, '\0');
+    for (std::size_t band = 0; band < grid.rows; band += MappedGrid::TILE) {
+        grid.advise_rows(band + MappedGrid::TILE, band + 2 * MappedGrid::TILE, MappedGrid::ADVICE_WILL_NEED);
+        for (std::size_t row = band; row < std::min(grid.rows, band + MappedGrid::TILE); ++row) {
+            for (std::size_t column = 0; column < grid.columns; ++column) {
+                line[column] = grid.at_unchecked({(long)row, (long)column});
+            }
+            out << line << '\n';
+        }
+        grid.advise_rows(band, band + MappedGrid::TILE, MappedGrid::ADVICE_DONE);
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef AOC_MAPPED_GRID_H
+#define AOC_MAPPED_GRID_H
+
+#include <string>
+#include <utility>
+#include "grid.h"
+
+/*
+ * Grid stored in a memory-mapped file, for maps too large to keep in memory. Cells are laid out
+ * in TILE x TILE tiles, so walking down a column touches one page per tile instead of one per row.
+ * The kernel pages tiles in and out on demand, advise_rows() hints which bands come next or are done.
+ *
+ * Offers the cell accessors of Grid (rows, columns, at, at_unchecked, set_unchecked, contains),
+ * so templated algorithms like flood_fill and tilt run on it unchanged.
+ */
+class MappedGrid {
+    int fd = -1;
+    char *cells = nullptr;
+    std::size_t mapped_bytes = 0;
+    std::size_t tile_columns = 0;
+
+    // Takes ownership of the open backing file
+    MappedGrid(int fd, std::size_t rows, std::size_t columns);
+
+    [[nodiscard]] std::size_t cell_offset(const GridCell& cell) const noexcept {
+        const std::size_t tile = (cell.row / TILE) * tile_columns + cell.column / TILE;
+        return tile * TILE * TILE + (cell.row % TILE) * TILE + cell.column % TILE;
+    }
+
+    // Byte range of the tiles covering rows [first_row, last_row)
+    [[nodiscard]] std::pair<std::size_t, std::size_t> band_bytes(std::size_t first_row, std::size_t last_row) const;
+
+public:
+    // 64 x 64 chars is one 4 KiB page per tile
+    static constexpr std::size_t TILE = 64;
+
+    std::size_t rows = 0;
+    std::size_t columns = 0;
+
+    MappedGrid(const MappedGrid&) = delete;
+    MappedGrid& operator=(const MappedGrid&) = delete;
+    MappedGrid(MappedGrid&& other) noexcept;
+    MappedGrid& operator=(MappedGrid&& other) noexcept;
+    ~MappedGrid();
+
+    [[nodiscard]] char at(const GridCell& cell) const noexcept;
+    [[nodiscard]] bool contains(const GridCell& cell) const;
+
+    [[nodiscard]]
+    char at_unchecked(const GridCell& cell) const noexcept {
+        return cells[cell_offset(cell)];
+    }
+
+    void set_unchecked(const GridCell& cell, const char& c) noexcept {
+        cells[cell_offset(cell)] = c;
+    }
+
+    typedef enum Advice {
+        // The rows are about to be used, start reading them in
+        ADVICE_WILL_NEED,
+        // The rows are done with for now, their pages can be written back and dropped
+        ADVICE_DONE,
+    } Advice;
+
+    void advise_rows(std::size_t first_row, std::size_t last_row, Advice advice);
+
+    /**
+     * Flushes the changes to the backing file
+     */
+    void sync();
+
+    friend MappedGrid make_mapped_grid(const std::string& path, std::size_t rows, std::size_t columns, char fill_char);
+    friend MappedGrid open_mapped_grid(const std::string& path, std::size_t rows, std::size_t columns);
+};
+
+/**
+ * Creates (or truncates) the backing file at path, filled with fill_char
+ *
+ * @throws std::system_error if the file cannot be created or mapped
+ */
+MappedGrid make_mapped_grid(const std::string& path, std::size_t rows, std::size_t columns, char fill_char);
+
+/**
+ * Maps an existing backing file of a grid with these dimensions
+ *
+ * @throws std::system_error if the file cannot be opened or mapped
+ * @throws std::logic_error if the file size does not match the dimensions
+ */
+MappedGrid open_mapped_grid(const std::string& path, std::size_t rows, std::size_t columns);
+
+/**
+ * Streams a text grid (one line per row) from in_path into a new backing file at path,
+ * a band of TILE rows at a time, so neither the text nor the grid is ever fully in memory
+ *
+ * @throws std::logic_error if the rows are not all of the same length
+ */
+MappedGrid make_mapped_grid(const std::string& in_path, const std::string& path);
+
+/**
+ * Streams the grid back out as text, one line per row
+ */
+void write_mapped_grid(MappedGrid& grid, const std::string& out_path);
+
+#endif
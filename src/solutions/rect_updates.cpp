@@ -0,0 +1,135 @@
+#include "rect_updates.h"
+
+#include <bit>
+#include <cstdint>
+#include <numeric>
+
+DifferenceGrid::DifferenceGrid(std::size_t rows, std::size_t columns):
+    rows(rows),
+    columns(columns),
+    differences((rows + 1) * (columns + 1), 0) {}
+
+void DifferenceGrid::add(const GridCell &from, const GridCell &to, long delta) {
+    long first_row = std::max(0l, std::min(from.row, to.row));
+    long last_row = std::min((long)rows - 1, std::max(from.row, to.row));
+    long first_column = std::max(0l, std::min(from.column, to.column));
+    long last_column = std::min((long)columns - 1, std::max(from.column, to.column));
+    if (first_row > last_row || first_column > last_column) return;
+
+    const auto stride = (long)columns + 1;
+    differences[first_row * stride + first_column] += delta;
+    differences[first_row * stride + last_column + 1] -= delta;
+    differences[(last_row + 1) * stride + first_column] -= delta;
+    differences[(last_row + 1) * stride + last_column + 1] += delta;
+}
+
+std::vector<long> DifferenceGrid::resolve() const {
+    std::vector<long> values(rows * columns);
+    std::vector<long> column_sums(columns, 0);
+    const std::size_t stride = columns + 1;
+
+    for (std::size_t row = 0; row < rows; ++row) {
+        // Vertical prefix sums run over whole rows, which vectorises
+        const long *difference_row = differences.data() + row * stride;
+        for (std::size_t column = 0; column < columns; ++column) {
+            column_sums[column] += difference_row[column];
+        }
+        std::inclusive_scan(column_sums.begin(), column_sums.end(), values.begin() + (long)(row * columns));
+    }
+
+    return values;
+}
+
+long DifferenceGrid::sum() const {
+    auto values = resolve();
+    return std::accumulate(values.begin(), values.end(), 0l);
+}
+
+std::size_t CompressedAxis::index_of(long coordinate) const {
+    return std::lower_bound(bounds.begin(), bounds.end(), coordinate) - bounds.begin();
+}
+
+static CompressedAxis make_axis(std::vector<long> bounds) {
+    std::sort(bounds.begin(), bounds.end());
+    bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+    return CompressedAxis{bounds};
+}
+
+CompressedAxis compress_rows(const std::vector<RectUpdate> &updates) {
+    std::vector<long> bounds;
+    bounds.reserve(updates.size() * 2);
+    for (const auto &update: updates) {
+        bounds.push_back(std::min(update.from.row, update.to.row));
+        bounds.push_back(std::max(update.from.row, update.to.row) + 1);
+    }
+    return make_axis(bounds);
+}
+
+CompressedAxis compress_columns(const std::vector<RectUpdate> &updates) {
+    std::vector<long> bounds;
+    bounds.reserve(updates.size() * 2);
+    for (const auto &update: updates) {
+        bounds.push_back(std::min(update.from.column, update.to.column));
+        bounds.push_back(std::max(update.from.column, update.to.column) + 1);
+    }
+    return make_axis(bounds);
+}
+
+// Mask of bits [from, to) of the word with index word
+static uint64_t word_mask(std::size_t word, std::size_t from, std::size_t to) {
+    std::size_t word_start = word * 64;
+    std::size_t low = std::max(from, word_start) - word_start;
+    std::size_t high = std::min(to, word_start + 64) - word_start;
+    uint64_t upper = high == 64 ? ~0ull : ((1ull << high) - 1);
+    return upper & ~((1ull << low) - 1);
+}
+
+long count_set_cells(const std::vector<RectUpdate> &updates) {
+    auto row_axis = compress_rows(updates);
+    auto column_axis = compress_columns(updates);
+
+    std::vector<std::size_t> first_rows, last_rows, first_columns, last_columns;
+    for (const auto &update: updates) {
+        first_rows.push_back(row_axis.index_of(std::min(update.from.row, update.to.row)));
+        last_rows.push_back(row_axis.index_of(std::max(update.from.row, update.to.row) + 1));
+        first_columns.push_back(column_axis.index_of(std::min(update.from.column, update.to.column)));
+        last_columns.push_back(column_axis.index_of(std::max(update.from.column, update.to.column) + 1));
+    }
+
+    const std::size_t words = (row_axis.intervals() + 63) / 64;
+    std::vector<uint64_t> bits(words);
+
+    long total = 0;
+    for (std::size_t column = 0; column < column_axis.intervals(); ++column) {
+        std::fill(bits.begin(), bits.end(), 0);
+
+        for (std::size_t i = 0; i < updates.size(); ++i) {
+            if (column < first_columns[i] || last_columns[i] <= column) continue;
+
+            for (std::size_t word = first_rows[i] / 64; word * 64 < last_rows[i]; ++word) {
+                uint64_t mask = word_mask(word, first_rows[i], last_rows[i]);
+                switch (updates[i].operation) {
+                    case RECT_SET:
+                        bits[word] |= mask;
+                        break;
+                    case RECT_RESET:
+                        bits[word] &= ~mask;
+                        break;
+                    case RECT_TOGGLE:
+                        bits[word] ^= mask;
+                        break;
+                }
+            }
+        }
+
+        long column_total = 0;
+        for (std::size_t word = 0; word < words; ++word) {
+            for (uint64_t remaining = bits[word]; remaining != 0; remaining &= remaining - 1) {
+                column_total += row_axis.length(word * 64 + std::countr_zero(remaining));
+            }
+        }
+        total += column_total * column_axis.length(column);
+    }
+
+    return total;
+}
@@ -0,0 +1,120 @@
+#ifndef AOC_RECT_UPDATES_H
+#define AOC_RECT_UPDATES_H
+
+#include <algorithm>
+#include <vector>
+#include "grid.h"
+
+typedef enum RectOperation {
+    RECT_SET,
+    RECT_RESET,
+    RECT_TOGGLE,
+} RectOperation;
+
+/*
+ * Operation over the rectangle between from and to, both corners inclusive
+ */
+typedef struct RectUpdate {
+    RectOperation operation;
+    GridCell from;
+    GridCell to;
+} RectUpdate;
+
+/*
+ * Additive rectangle updates through a 2D difference array. Every update is O(1),
+ * the actual values are materialised once by resolve() with a pass of prefix sums.
+ */
+class DifferenceGrid {
+    std::size_t rows;
+    std::size_t columns;
+    // One extra row and column so updates reaching the edge need no special casing
+    std::vector<long> differences;
+
+public:
+    DifferenceGrid(std::size_t rows, std::size_t columns);
+
+    /**
+     * Adds delta to every cell between from and to (both inclusive), clipped to the grid
+     */
+    void add(const GridCell& from, const GridCell& to, long delta);
+
+    /**
+     * @return row-major values of all cells
+     */
+    [[nodiscard]] std::vector<long> resolve() const;
+    [[nodiscard]] long sum() const;
+};
+
+/*
+ * Breakpoints of one axis after coordinate compression. Interval i covers [bounds[i], bounds[i + 1]).
+ */
+typedef struct CompressedAxis {
+    std::vector<long> bounds;
+
+    [[nodiscard]] std::size_t intervals() const { return bounds.empty() ? 0 : bounds.size() - 1; }
+    [[nodiscard]] long length(std::size_t interval) const { return bounds[interval + 1] - bounds[interval]; }
+    [[nodiscard]] std::size_t index_of(long coordinate) const;
+} CompressedAxis;
+
+CompressedAxis compress_rows(const std::vector<RectUpdate>& updates);
+CompressedAxis compress_columns(const std::vector<RectUpdate>& updates);
+
+/**
+ * Applies the updates in order on an unbounded plane of default constructed values, through
+ * coordinate compression and a sweep over the distinct column intervals. Cells covered by the same
+ * set of rectangles always share a value, so each compressed cell is updated once per rectangle
+ * covering it and the cost does not depend on the area.
+ *
+ * @param apply called as apply(Value&, const RectUpdate&)
+ * @param measure maps a final value to its contribution per cell
+ * @return sum of measure(value) over all the cells
+ */
+template<typename Value, typename Apply, typename Measure>
+long sweep_rectangles(const std::vector<RectUpdate>& updates, Apply apply, Measure measure) {
+    auto row_axis = compress_rows(updates);
+    auto column_axis = compress_columns(updates);
+
+    // Compressed bounds of every update, so the sweep does not search for them again
+    typedef struct Span {
+        std::size_t first_row, last_row, first_column, last_column;
+    } Span;
+    std::vector<Span> spans;
+    spans.reserve(updates.size());
+    for (const auto& update: updates) {
+        spans.push_back(Span{
+                row_axis.index_of(std::min(update.from.row, update.to.row)),
+                row_axis.index_of(std::max(update.from.row, update.to.row) + 1),
+                column_axis.index_of(std::min(update.from.column, update.to.column)),
+                column_axis.index_of(std::max(update.from.column, update.to.column) + 1),
+        });
+    }
+
+    long total = 0;
+    std::vector<Value> values(row_axis.intervals());
+    for (std::size_t column = 0; column < column_axis.intervals(); ++column) {
+        std::fill(values.begin(), values.end(), Value{});
+
+        for (std::size_t i = 0; i < updates.size(); ++i) {
+            if (column < spans[i].first_column || spans[i].last_column <= column) continue;
+            for (std::size_t row = spans[i].first_row; row < spans[i].last_row; ++row) {
+                apply(values[row], updates[i]);
+            }
+        }
+
+        long column_total = 0;
+        for (std::size_t row = 0; row < values.size(); ++row) {
+            column_total += measure(values[row]) * row_axis.length(row);
+        }
+        total += column_total * column_axis.length(column);
+    }
+
+    return total;
+}
+
+/**
+ * Number of cells left set after applying set/reset/toggle updates in order to an empty plane.
+ * Same sweep as sweep_rectangles, but each column interval keeps the compressed rows as a bitset.
+ */
+long count_set_cells(const std::vector<RectUpdate>& updates);
+
+#endif
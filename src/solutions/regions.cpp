@@ -0,0 +1,121 @@
+#include "regions.h"
+
+#include <algorithm>
+#include <thread>
+
+int RegionLabels::at(const GridCell &cell) const noexcept {
+    if (cell.row < 0 || cell.row >= rows || cell.column < 0 || cell.column >= columns) return -1;
+    return labels[cell.row * columns + cell.column];
+}
+
+// Union-find over cell indices, always linking to the smaller root. The root of a region is
+// then its first cell in row-major order and every parent comes before its child.
+static int find_root(std::vector<int> &parents, int cell) {
+    while (parents[cell] != cell) {
+        parents[cell] = parents[parents[cell]];
+        cell = parents[cell];
+    }
+    return cell;
+}
+
+static void unite(std::vector<int> &parents, int a, int b) {
+    a = find_root(parents, a);
+    b = find_root(parents, b);
+    if (a == b) return;
+    if (a < b) std::swap(a, b);
+    parents[a] = b;
+}
+
+// Links the cells of rows [first_row, last_row) to their left and upper neighbours inside the band
+static void label_band(const Grid &grid, char skip, std::vector<int> &parents, long first_row, long last_row) {
+    const auto columns = (long)grid.columns;
+    for (long row = first_row; row < last_row; ++row) {
+        for (long column = 0; column < columns; ++column) {
+            char value = grid.at_unchecked({row, column});
+            if (value == skip) continue;
+
+            int cell = (int)(row * columns + column);
+            if (column > 0 && grid.at_unchecked({row, column - 1}) == value) {
+                unite(parents, cell, cell - 1);
+            }
+            if (row > first_row && grid.at_unchecked({row - 1, column}) == value) {
+                unite(parents, cell, (int)(cell - columns));
+            }
+        }
+    }
+}
+
+RegionLabels label_regions(const Grid &grid, char skip, unsigned threads) {
+    const auto rows = (long)grid.rows;
+    const auto columns = (long)grid.columns;
+    RegionLabels result{grid.rows, grid.columns, std::vector<int>(grid.rows * grid.columns, -1), {}};
+
+    std::vector<int> parents(rows * columns);
+    for (int cell = 0; cell < parents.size(); ++cell) {
+        parents[cell] = cell;
+    }
+
+    // 1. Label bands of rows independently, unions never leave the band
+    threads = std::max(1u, std::min(threads, (unsigned)std::max(1l, rows)));
+    long band_rows = (rows + threads - 1) / threads;
+    std::vector<long> band_starts;
+    for (long row = 0; row < rows; row += band_rows) {
+        band_starts.push_back(row);
+    }
+
+    if (band_starts.size() <= 1) {
+        label_band(grid, skip, parents, 0, rows);
+    } else {
+        std::vector<std::thread> workers;
+        for (auto band_start: band_starts) {
+            workers.emplace_back(label_band, std::cref(grid), skip, std::ref(parents), band_start, std::min(rows, band_start + band_rows));
+        }
+        for (auto &worker: workers) {
+            worker.join();
+        }
+
+        // 2. Merge the labels across the band boundaries
+        for (std::size_t band = 1; band < band_starts.size(); ++band) {
+            long row = band_starts[band];
+            for (long column = 0; column < columns; ++column) {
+                char value = grid.at_unchecked({row, column});
+                if (value == skip || grid.at_unchecked({row - 1, column}) != value) continue;
+                int cell = (int)(row * columns + column);
+                unite(parents, cell, (int)(cell - columns));
+            }
+        }
+    }
+
+    // 3. Roots come first in row-major order, so one pass is enough to give out compact labels
+    for (long row = 0; row < rows; ++row) {
+        for (long column = 0; column < columns; ++column) {
+            char value = grid.at_unchecked({row, column});
+            if (value == skip) continue;
+
+            int cell = (int)(row * columns + column);
+            int root = find_root(parents, cell);
+            if (root == cell) {
+                result.labels[cell] = (int)result.regions.size();
+                result.regions.push_back(Region{value, 0, 0, GridCell{row, column}});
+            } else {
+                result.labels[cell] = result.labels[root];
+            }
+        }
+    }
+
+    // 4. Sizes and perimeters
+    for (long row = 0; row < rows; ++row) {
+        for (long column = 0; column < columns; ++column) {
+            int label = result.labels[row * columns + column];
+            if (label < 0) continue;
+
+            auto &region = result.regions[label];
+            region.size++;
+            for (const auto &offset: NEIGHBOURS_4) {
+                if (result.at(GridCell{row, column} + offset) != label) region.perimeter++;
+            }
+        }
+    }
+
+    return result;
+}
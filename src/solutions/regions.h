@@ -0,0 +1,91 @@
+#ifndef AOC_REGIONS_H
+#define AOC_REGIONS_H
+
+#include <stack>
+#include <vector>
+#include "grid.h"
+
+typedef struct Region {
+    char value;
+    std::size_t size;
+    // Number of cell sides touching another region or the edge of the grid
+    std::size_t perimeter;
+    // First cell of the region in row-major order
+    GridCell first_cell;
+} Region;
+
+/*
+ * Every cell of the grid labelled with the index of its region, -1 for cells that were skipped
+ */
+typedef struct RegionLabels {
+    std::size_t rows;
+    std::size_t columns;
+    std::vector<int> labels;
+    std::vector<Region> regions;
+
+    /**
+     * @return label of the cell, -1 if the cell is skipped or outside of the grid
+     */
+    [[nodiscard]] int at(const GridCell& cell) const noexcept;
+} RegionLabels;
+
+/**
+ * Replaces the 4-connected area of cells equal to the start cell with replacement.
+ * Uses scanline filling with an explicit stack, so large areas cannot overflow the call stack.
+ * Works on any grid with the cell accessors of Grid, MappedGrid included.
+ *
+ * @return number of cells filled
+ */
+template<typename CellGrid>
+std::size_t flood_fill(CellGrid& grid, const GridCell& start, char replacement) {
+    if (!grid.contains(start)) return 0;
+    const char target = grid.at(start);
+    if (target == replacement) return 0;
+
+    const auto columns = (long)grid.columns;
+    std::size_t filled = 0;
+    std::stack<GridCell> seeds;
+    seeds.push(start);
+
+    while (!seeds.empty()) {
+        auto seed = seeds.top();
+        seeds.pop();
+        if (grid.at_unchecked(seed) != target) continue;
+
+        // Extend the seed to the whole span of the row
+        long left = seed.column;
+        long right = seed.column;
+        while (left > 0 && grid.at_unchecked({seed.row, left - 1}) == target) left--;
+        while (right < columns - 1 && grid.at_unchecked({seed.row, right + 1}) == target) right++;
+
+        for (long column = left; column <= right; ++column) {
+            grid.set_unchecked({seed.row, column}, replacement);
+        }
+        filled += right - left + 1;
+
+        // One seed for every run of target cells just above and below the span
+        for (long row: {seed.row - 1, seed.row + 1}) {
+            if (row < 0 || row >= grid.rows) continue;
+            bool in_run = false;
+            for (long column = left; column <= right; ++column) {
+                bool matches = grid.at_unchecked({row, column}) == target;
+                if (matches && !in_run) seeds.push({row, column});
+                in_run = matches;
+            }
+        }
+    }
+
+    return filled;
+}
+
+/**
+ * Splits the grid into 4-connected regions of equal characters, labelled in row-major order
+ * of their first cell. Cells equal to skip are left unlabelled.
+ *
+ * With more threads the grid is cut into bands of rows which are labelled in parallel,
+ * the union-find labels are then merged across the band boundaries.
+ * The result does not depend on the number of threads.
+ */
+RegionLabels label_regions(const Grid& grid, char skip = '\0', unsigned threads = 1);
+
+#endif
@@ -0,0 +1,73 @@
+#include "sparse_grid.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+const SparseTile *SparseGrid::find_tile(const GridCell &key) const {
+    if (last_tile < tiles.size() && tiles[last_tile].key == key) return &tiles[last_tile];
+
+    auto index = tile_indices.find(key);
+    if (index == nullptr) return nullptr;
+    last_tile = *index;
+    return &tiles[*index];
+}
+
+SparseTile &SparseGrid::tile_for(const GridCell &key) {
+    if (last_tile < tiles.size() && tiles[last_tile].key == key) return tiles[last_tile];
+    if (auto index = tile_indices.find(key)) {
+        last_tile = *index;
+        return tiles[*index];
+    }
+
+    last_tile = tiles.size();
+    tile_indices[key] = last_tile;
+    SparseTile &tile = tiles.emplace_back();
+    tile.key = key;
+    tile.cells.fill(background);
+    return tile;
+}
+
+char SparseGrid::at(const GridCell &cell) const {
+    auto tile = find_tile(tile_key(cell));
+    return tile == nullptr ? background : tile->cells[offset_in_tile(cell)];
+}
+
+void SparseGrid::set(const GridCell &cell, char c) {
+    if (c == background && find_tile(tile_key(cell)) == nullptr) return;
+    tile_for(tile_key(cell)).cells[offset_in_tile(cell)] = c;
+}
+
+std::size_t SparseGrid::count(char c) const {
+    std::size_t total = 0;
+    for (const auto &tile: tiles) {
+        total += std::count(tile.cells.begin(), tile.cells.end(), c);
+    }
+    return total;
+}
+
+std::optional<std::pair<GridCell, GridCell>> SparseGrid::bounds() const {
+    std::optional<std::pair<GridCell, GridCell>> result;
+    for_each_cell([&result](const GridCell &cell, char) {
+        if (!result.has_value()) {
+            result = {cell, cell};
+            return;
+        }
+        auto &[top_left, bottom_right] = result.value();
+        top_left = GridCell{std::min(top_left.row, cell.row), std::min(top_left.column, cell.column)};
+        bottom_right = GridCell{std::max(bottom_right.row, cell.row), std::max(bottom_right.column, cell.column)};
+    });
+    return result;
+}
+
+Grid SparseGrid::to_grid() const {
+    auto area = bounds();
+    if (!area.has_value()) throw std::logic_error("Sparse grid has no cells to render");
+
+    const auto &[top_left, bottom_right] = area.value();
+    auto grid = make_grid(bottom_right.row - top_left.row + 1, bottom_right.column - top_left.column + 1, background);
+    grid.origin = GridCell{0, 0} - top_left;
+    for_each_cell([&grid](const GridCell &cell, char value) {
+        grid.set_unchecked(cell + grid.origin, value);
+    });
+    return grid;
+}
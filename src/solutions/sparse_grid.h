@@ -0,0 +1,97 @@
+#ifndef AOC_SPARSE_GRID_H
+#define AOC_SPARSE_GRID_H
+
+#include <array>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "grid.h"
+#include "cell_set.h"
+
+/*
+ * Dense square block of a SparseGrid, SIZE cells per side
+ */
+typedef struct SparseTile {
+    static constexpr long SHIFT = 6;
+    static constexpr long SIZE = 1 << SHIFT;
+    static constexpr long MASK = SIZE - 1;
+
+    // Coordinates of the tile itself, cell >> SHIFT on both axes
+    GridCell key;
+    std::array<char, SIZE * SIZE> cells;
+} SparseTile;
+
+/*
+ * Unbounded grid for simulations of unknown extent. The plane is split into dense tiles held
+ * in a CellMap by tile coordinate, tiles are only allocated on the first write of a non-background
+ * cell. The last tile used is remembered, so runs of nearby accesses skip the hash lookup.
+ */
+class SparseGrid {
+    char background;
+    std::vector<SparseTile> tiles;
+    CellMap<std::size_t> tile_indices;
+    mutable std::size_t last_tile = 0;
+
+    [[nodiscard]] const SparseTile* find_tile(const GridCell& key) const;
+    SparseTile& tile_for(const GridCell& key);
+
+    static GridCell tile_key(const GridCell& cell) {
+        return GridCell{cell.row >> SparseTile::SHIFT, cell.column >> SparseTile::SHIFT};
+    }
+
+    static std::size_t offset_in_tile(const GridCell& cell) {
+        return (cell.row & SparseTile::MASK) * SparseTile::SIZE + (cell.column & SparseTile::MASK);
+    }
+
+public:
+    explicit SparseGrid(char background = '.'): background(background) {}
+
+    /**
+     * @return the cell, or the background if it was never written
+     */
+    [[nodiscard]] char at(const GridCell& cell) const;
+    void set(const GridCell& cell, char c);
+
+    [[nodiscard]] std::size_t tile_count() const { return tiles.size(); }
+    [[nodiscard]] std::size_t count(char c) const;
+
+    /**
+     * @return the smallest rectangle holding every non-background cell, as its top-left and bottom-right cell
+     */
+    [[nodiscard]] std::optional<std::pair<GridCell, GridCell>> bounds() const;
+
+    /**
+     * Calls fn(const SparseTile&) for every allocated tile, in no particular order
+     */
+    template<typename Fn>
+    void for_each_tile(Fn fn) const {
+        for (const auto& tile: tiles) {
+            fn(tile);
+        }
+    }
+
+    /**
+     * Calls fn(GridCell, char) for every non-background cell, in no particular order
+     */
+    template<typename Fn>
+    void for_each_cell(Fn fn) const {
+        for (const auto& tile: tiles) {
+            const GridCell first{tile.key.row * SparseTile::SIZE, tile.key.column * SparseTile::SIZE};
+            for (long row = 0; row < SparseTile::SIZE; ++row) {
+                for (long column = 0; column < SparseTile::SIZE; ++column) {
+                    char value = tile.cells[row * SparseTile::SIZE + column];
+                    if (value != background) fn(first + GridCell{row, column}, value);
+                }
+            }
+        }
+    }
+
+    /**
+     * Dense copy of bounds(), with `origin` set so a sparse cell sits at `cell + origin` in the grid
+     *
+     * @throws std::logic_error if there is nothing but background
+     */
+    [[nodiscard]] Grid to_grid() const;
+};
+
+#endif
@@ -0,0 +1,56 @@
+#include "summed_area.h"
+
+#include <algorithm>
+#include <numeric>
+
+void SummedAreaTable::add_row(std::size_t row, const std::vector<long> &values) {
+    const std::size_t stride = columns + 1;
+    const long *above = sums.data() + row * stride;
+    long *current = sums.data() + (row + 1) * stride;
+
+    std::inclusive_scan(values.begin(), values.end(), current + 1);
+    for (std::size_t column = 1; column <= columns; ++column) {
+        current[column] += above[column];
+    }
+}
+
+long SummedAreaTable::rectangle(const GridCell &from, const GridCell &to) const {
+    long first_row = std::max(0l, std::min(from.row, to.row));
+    long last_row = std::min((long)rows - 1, std::max(from.row, to.row));
+    long first_column = std::max(0l, std::min(from.column, to.column));
+    long last_column = std::min((long)columns - 1, std::max(from.column, to.column));
+    if (first_row > last_row || first_column > last_column) return 0;
+
+    const auto stride = (long)columns + 1;
+    return sums[(last_row + 1) * stride + last_column + 1]
+           - sums[first_row * stride + last_column + 1]
+           - sums[(last_row + 1) * stride + first_column]
+           + sums[first_row * stride + first_column];
+}
+
+long SummedAreaTable::row_span(long row, long first_column, long last_column) const {
+    return rectangle({row, first_column}, {row, last_column});
+}
+
+long SummedAreaTable::column_span(long column, long first_row, long last_row) const {
+    return rectangle({first_row, column}, {last_row, column});
+}
+
+long SummedAreaTable::total() const {
+    return sums.back();
+}
+
+SummedAreaTable make_summed_area_table(const Grid &grid, char c) {
+    return make_summed_area_table(grid, [c](char value) {
+        return value == c;
+    });
+}
+
+SummedAreaTable make_summed_area_table(const BitGrid &grid) {
+    return {grid.rows, grid.columns, [&grid](std::size_t row, std::vector<long> &values) {
+        const uint64_t *words = grid.row(row);
+        for (std::size_t column = 0; column < grid.columns; ++column) {
+            values[column] = (long)((words[column / 64] >> (column % 64)) & 1);
+        }
+    }};
+}
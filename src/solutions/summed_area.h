@@ -0,0 +1,71 @@
+#ifndef AOC_SUMMED_AREA_H
+#define AOC_SUMMED_AREA_H
+
+#include <vector>
+#include "grid.h"
+#include "bit_grid.h"
+
+/*
+ * Summed-area table - sums[r][c] holds the total of all cells above and left of (r, c), exclusive.
+ * Any rectangle total is then four lookups.
+ */
+class SummedAreaTable {
+    std::size_t rows;
+    std::size_t columns;
+    // (rows + 1) x (columns + 1), the first row and column stay zero
+    std::vector<long> sums;
+
+    void add_row(std::size_t row, const std::vector<long>& values);
+
+public:
+    /**
+     * Builds the table row by row, fill_row(row, values) has to write the values of the cells in the row.
+     * Each row is prefix-summed and added onto the previous one, which the compiler vectorises.
+     */
+    template<typename FillRow>
+    SummedAreaTable(std::size_t rows, std::size_t columns, FillRow fill_row):
+        rows(rows),
+        columns(columns),
+        sums((rows + 1) * (columns + 1), 0) {
+        std::vector<long> values(columns);
+        for (std::size_t row = 0; row < rows; ++row) {
+            fill_row(row, values);
+            add_row(row, values);
+        }
+    }
+
+    /**
+     * Total of the rectangle between from and to (both inclusive), clipped to the table
+     */
+    [[nodiscard]] long rectangle(const GridCell& from, const GridCell& to) const;
+
+    /**
+     * Total of columns first_column..last_column (inclusive) of one row
+     */
+    [[nodiscard]] long row_span(long row, long first_column, long last_column) const;
+
+    /**
+     * Total of rows first_row..last_row (inclusive) of one column
+     */
+    [[nodiscard]] long column_span(long column, long first_row, long last_row) const;
+
+    [[nodiscard]] long total() const;
+};
+
+/**
+ * @return table counting the cells matching predicate(char)
+ */
+template<typename Predicate>
+SummedAreaTable make_summed_area_table(const Grid& grid, Predicate predicate) {
+    return {grid.rows, grid.columns, [&grid, &predicate](std::size_t row, std::vector<long>& values) {
+        const char *cells = grid.data.data() + grid.storage_idx({(long)row, 0});
+        for (std::size_t column = 0; column < grid.columns; ++column) {
+            values[column] = predicate(cells[column]) ? 1 : 0;
+        }
+    }};
+}
+
+SummedAreaTable make_summed_area_table(const Grid& grid, char c);
+SummedAreaTable make_summed_area_table(const BitGrid& grid);
+
+#endif
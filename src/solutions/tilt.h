@@ -0,0 +1,87 @@
+#ifndef AOC_TILT_H
+#define AOC_TILT_H
+
+#include <stdexcept>
+#include <vector>
+#include "grid.h"
+
+/*
+ * North and south walk the rows in order and keep the next free row of every column, so the
+ * inner loop runs along a row of memory instead of striding down a column.
+ */
+template<typename CellGrid>
+std::size_t tilt_vertical(CellGrid& grid, long step, char rolling, char empty) {
+    const auto rows = (long)grid.rows;
+    const auto columns = (long)grid.columns;
+    const long first_row = step < 0 ? 0 : rows - 1;
+    const long end_row = step < 0 ? rows : -1;
+
+    std::size_t moved = 0;
+    std::vector<long> next_free(columns, first_row);
+    for (long row = first_row; row != end_row; row -= step) {
+        for (long column = 0; column < columns; ++column) {
+            char value = grid.at_unchecked({row, column});
+            if (value == rolling) {
+                if (next_free[column] != row) {
+                    grid.set_unchecked({next_free[column], column}, rolling);
+                    grid.set_unchecked({row, column}, empty);
+                    moved++;
+                }
+                next_free[column] -= step;
+            } else if (value != empty) {
+                next_free[column] = row - step;
+            }
+        }
+    }
+    return moved;
+}
+
+// East and west compact each row on its own, the row is contiguous already
+template<typename CellGrid>
+std::size_t tilt_horizontal(CellGrid& grid, long step, char rolling, char empty) {
+    const auto rows = (long)grid.rows;
+    const auto columns = (long)grid.columns;
+    const long first_column = step < 0 ? 0 : columns - 1;
+    const long end_column = step < 0 ? columns : -1;
+
+    std::size_t moved = 0;
+    for (long row = 0; row < rows; ++row) {
+        long next_free = first_column;
+        for (long column = first_column; column != end_column; column -= step) {
+            char value = grid.at_unchecked({row, column});
+            if (value == rolling) {
+                if (next_free != column) {
+                    grid.set_unchecked({row, next_free}, rolling);
+                    grid.set_unchecked({row, column}, empty);
+                    moved++;
+                }
+                next_free -= step;
+            } else if (value != empty) {
+                next_free = column - step;
+            }
+        }
+    }
+    return moved;
+}
+
+/**
+ * Rolls every `rolling` cell as far as it goes towards direction, over `empty` cells only.
+ * Any other character is a fixed obstacle, so each row or column is compacted segment by segment.
+ * Works in place without rotating, on any grid with the cell accessors of Grid (MappedGrid included).
+ * A Grid keeps its hash up to date.
+ *
+ * @param direction one of NEIGHBOURS_4
+ * @return number of cells that moved
+ */
+template<typename CellGrid>
+std::size_t tilt(CellGrid& grid, const GridCell& direction, char rolling = 'O', char empty = '.') {
+    if (direction.column == 0 && (direction.row == -1 || direction.row == 1)) {
+        return tilt_vertical(grid, direction.row, rolling, empty);
+    }
+    if (direction.row == 0 && (direction.column == -1 || direction.column == 1)) {
+        return tilt_horizontal(grid, direction.column, rolling, empty);
+    }
+    throw std::logic_error("Tilt direction must be one of NEIGHBOURS_4");
+}
+
+#endif
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <random>
+
+#include "../src/solutions/all_pairs.h"
+#include "../src/solutions/grid_graph.h"
+
+TEST(AllPairs, floydWarshallSmall) {
+    auto graph = Graph(4);
+    graph.add_directed_edge(0, 5, 1);
+    graph.add_directed_edge(0, 1, 2);
+    graph.add_directed_edge(2, 1, 1);
+    graph.add_directed_edge(1, -2, 3);
+
+    auto matrix = all_pairs_distances(graph);
+
+    ASSERT_EQ(matrix.at(0, 1), 2);
+    ASSERT_EQ(matrix.at(0, 3), 0);
+    ASSERT_EQ(matrix.at(2, 3), -1);
+    ASSERT_EQ(matrix.at(1, 1), 0);
+    ASSERT_EQ(matrix.at(3, 0), std::numeric_limits<long>::max());
+    ASSERT_EQ(matrix.at(1, 2), std::numeric_limits<long>::max());
+}
+
+TEST(AllPairs, floydWarshallMatchesDijkstraOverManyBlocks) {
+    // Not a multiple of the block size, so padding is exercised too
+    const long nodes = 3 * (long)DISTANCE_BLOCK + 7;
+    std::mt19937 random(7);
+    std::uniform_int_distribution<long> node(0, nodes - 1), weight(0, 100);
+
+    auto graph = Graph(nodes);
+    for (long i = 0; i < nodes * 4; ++i) {
+        long from = node(random), to = node(random);
+        if (from != to) graph.add_directed_edge(from, weight(random), to);
+    }
+
+    auto matrix = all_pairs_distances(graph);
+    for (long source = 0; source < nodes; ++source) {
+        auto distances = dijkstra_distances(graph, source);
+        for (long destination = 0; destination < nodes; ++destination) {
+            ASSERT_EQ(matrix.at(source, destination), distances[destination]);
+        }
+    }
+}
+
+TEST(AllPairs, keyPointsKeepDistances) {
+    auto grid = make_grid(
+            "#######\n"
+            "#0.1.2#\n"
+            "####.##\n"
+            "#3...##\n"
+            "#######\n");
+    auto graph = GridGraph(grid, [](char from, char to) {
+        return from == '#' || to == '#' ? std::nullopt : std::optional<long>(1);
+    });
+
+    std::vector<long> key_points;
+    for (char key = '0'; key <= '3'; ++key) {
+        key_points.push_back((long)grid.underlying_idx(grid.find_first(key)));
+    }
+
+    auto compressed = compress_key_points(graph, key_points);
+    ASSERT_EQ(compressed.size(), 4);
+    // 0 only reaches 2 and 3 through 1, which reaches both directly
+    ASSERT_EQ(compressed.edges_of(0).size(), 1);
+    ASSERT_EQ(compressed.edges_of(1).size(), 3);
+
+    auto distances = key_point_distances(graph, key_points);
+    for (std::size_t from = 0; from < key_points.size(); ++from) {
+        auto expected = bfs_search(graph, {key_points[from]}).distances;
+        for (std::size_t to = 0; to < key_points.size(); ++to) {
+            ASSERT_EQ(distances.at((long)from, (long)to), expected[key_points[to]]);
+        }
+    }
+}
+
+TEST(AllPairs, keyPointsOverSeveralBatches) {
+    auto grid = make_grid(std::string(100, '.') + "\n");
+    auto graph = GridGraph(grid, [](char, char) { return std::optional<long>(2); });
+
+    std::vector<long> key_points;
+    for (long column = 0; column < 100; column += 1) key_points.push_back(column);
+
+    auto compressed = compress_key_points(graph, key_points);
+    // Every key point only sees its direct neighbours
+    ASSERT_EQ(compressed.edge_count(), 198);
+
+    auto distances = all_pairs_distances(compressed);
+    ASSERT_EQ(distances.at(0, 99), 198);
+    ASSERT_EQ(distances.at(70, 3), 134);
+}
+
+TEST(AllPairs, keyPointsAlongLongCorridor) {
+    // Snake maze, the key points at both ends are far more levels apart than there are key points
+    const std::size_t rows = 199, columns = 400;
+    std::string maze;
+    for (std::size_t row = 0; row < rows; ++row) {
+        std::string line(columns, '.');
+        if (row % 2 == 1) {
+            line.assign(columns, '#');
+            line[row % 4 == 1 ? columns - 1 : 0] = '.';
+        }
+        maze += line + "\n";
+    }
+    auto grid = make_grid(maze);
+    auto graph = GridGraph(grid, [](char from, char to) {
+        return from == '#' || to == '#' ? std::nullopt : std::optional<long>(1);
+    });
+
+    const std::vector<long> key_points = {0, (long)grid.underlying_idx({(long)rows - 1, (long)columns - 1})};
+    auto expected = bfs_search(graph, {key_points[0]}).distances[key_points[1]];
+    ASSERT_GT(expected, 39000);
+
+    auto compressed = compress_key_points(graph, key_points);
+    ASSERT_EQ(compressed.edge_count(), 2);
+    ASSERT_EQ(key_point_distances(graph, key_points).at(0, 1), expected);
+}
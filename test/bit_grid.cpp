@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "../src/solutions/bit_grid.h"
+
+TEST(BitGrid, set_and_test) {
+    BitGrid grid(3, 130);
+
+    ASSERT_TRUE(grid.set({0, 0}));
+    ASSERT_TRUE(grid.set({1, 64}));
+    ASSERT_TRUE(grid.set({2, 129}));
+    ASSERT_FALSE(grid.set({3, 0}));
+    ASSERT_FALSE(grid.set({0, 130}));
+    ASSERT_FALSE(grid.set({-1, 0}));
+
+    ASSERT_TRUE(grid.test({0, 0}));
+    ASSERT_TRUE(grid.test({1, 64}));
+    ASSERT_TRUE(grid.test({2, 129}));
+    ASSERT_FALSE(grid.test({1, 63}));
+    ASSERT_FALSE(grid.test({0, 130}));
+    ASSERT_EQ(grid.popcount(), 3);
+
+    grid.set({1, 64}, false);
+    grid.flip({2, 129});
+    grid.flip({2, 128});
+    ASSERT_FALSE(grid.test({1, 64}));
+    ASSERT_FALSE(grid.test({2, 129}));
+    ASSERT_TRUE(grid.test({2, 128}));
+    ASSERT_EQ(grid.popcount(), 2);
+}
+
+TEST(BitGrid, rectangles) {
+    BitGrid grid(1000, 1000);
+
+    // The 2015/06 example
+    grid.fill_rect({0, 0}, {999, 999});
+    ASSERT_EQ(grid.popcount(), 1'000'000);
+    grid.toggle_rect({0, 0}, {0, 999});
+    ASSERT_EQ(grid.popcount(), 999'000);
+    grid.fill_rect({499, 499}, {500, 500}, false);
+    ASSERT_EQ(grid.popcount(), 998'996);
+
+    ASSERT_FALSE(grid.test({0, 500}));
+    ASSERT_FALSE(grid.test({500, 499}));
+    ASSERT_TRUE(grid.test({501, 499}));
+    ASSERT_EQ(grid.popcount_row(0), 0);
+    ASSERT_EQ(grid.popcount_row(500), 998);
+
+    // Clipped to the grid
+    BitGrid small(2, 70);
+    small.toggle_rect({-5, 60}, {10, 100});
+    ASSERT_EQ(small.popcount(), 20);
+}
+
+TEST(BitGrid, row_operations) {
+    BitGrid grid(2, 100);
+    grid.fill_rect({0, 0}, {0, 49});
+    grid.fill_rect({1, 25}, {1, 74});
+
+    BitGrid copy = grid;
+    copy.and_row(0, grid, 1);
+    ASSERT_EQ(copy.popcount_row(0), 25);
+    copy = grid;
+    copy.or_row(0, grid, 1);
+    ASSERT_EQ(copy.popcount_row(0), 75);
+    copy = grid;
+    copy.xor_row(0, grid, 1);
+    ASSERT_EQ(copy.popcount_row(0), 50);
+
+    copy = grid;
+    copy ^= grid;
+    ASSERT_EQ(copy.popcount(), 0);
+    copy |= grid;
+    ASSERT_EQ(copy, grid);
+}
+
+TEST(BitGrid, shift_row) {
+    BitGrid grid(1, 100);
+    grid.fill_rect({0, 0}, {0, 9});
+
+    grid.shift_row(0, 60);
+    ASSERT_EQ(grid.popcount(), 10);
+    ASSERT_FALSE(grid.test({0, 59}));
+    ASSERT_TRUE(grid.test({0, 60}));
+    ASSERT_TRUE(grid.test({0, 69}));
+    ASSERT_FALSE(grid.test({0, 70}));
+
+    // Drops what falls off the edge
+    grid.shift_row(0, 35);
+    ASSERT_EQ(grid.popcount(), 5);
+    ASSERT_TRUE(grid.test({0, 95}));
+    ASSERT_TRUE(grid.test({0, 99}));
+
+    grid.shift_row(0, -95);
+    ASSERT_EQ(grid.popcount(), 5);
+    ASSERT_TRUE(grid.test({0, 0}));
+    ASSERT_TRUE(grid.test({0, 4}));
+
+    grid.shift_row(0, -100);
+    ASSERT_EQ(grid.popcount(), 0);
+}
+
+TEST(BitGrid, grid_conversion) {
+    auto grid = make_grid("#..#\n.##.\n");
+    auto bit_grid = make_bit_grid(grid, '#');
+
+    ASSERT_EQ(bit_grid.rows, 2);
+    ASSERT_EQ(bit_grid.columns, 4);
+    ASSERT_EQ(bit_grid.popcount(), 4);
+    ASSERT_TRUE(bit_grid.test({0, 3}));
+    ASSERT_TRUE(bit_grid.test({1, 1}));
+
+    auto back = make_grid(bit_grid, '#', '.');
+    ASSERT_EQ(back.packed_data(), grid.packed_data());
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include "../src/solutions/cell_set.h"
+
+TEST(PackedCell, conversion) {
+    GridCell cell{-3, 7};
+    PackedCell packed = cell;
+    ASSERT_EQ(packed.row, -3);
+    ASSERT_EQ(packed.column, 7);
+    ASSERT_EQ(GridCell(packed), cell);
+    ASSERT_EQ(PackedCell::from_key(packed.key()), packed);
+    ASSERT_NE(PackedCell(1, 2).key(), PackedCell(2, 1).key());
+
+    ASSERT_THROW(PackedCell(GridCell{1l << 31, 0}), std::out_of_range);
+    ASSERT_THROW(PackedCell(GridCell{0, -(1l << 31) - 1}), std::out_of_range);
+    ASSERT_EQ(PackedCell(GridCell{-(1l << 31), (1l << 31) - 1}).column, std::numeric_limits<int32_t>::max());
+}
+
+TEST(CellSet, insert_contains) {
+    CellSet set;
+    ASSERT_TRUE(set.empty());
+    ASSERT_TRUE(set.insert(GridCell{0, 0}));
+    ASSERT_FALSE(set.insert(GridCell{0, 0}));
+    ASSERT_TRUE(set.insert(GridCell{-1, 5}));
+    ASSERT_EQ(set.size(), 2);
+    ASSERT_TRUE(set.contains(GridCell{-1, 5}));
+    ASSERT_FALSE(set.contains(GridCell{5, -1}));
+
+    ASSERT_TRUE(set.erase(GridCell{0, 0}));
+    ASSERT_FALSE(set.erase(GridCell{0, 0}));
+    ASSERT_EQ(set.size(), 1);
+
+    ASSERT_THROW(set.insert(PackedCell(std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::min())), std::out_of_range);
+}
+
+TEST(CellSet, matches_std_set) {
+    std::mt19937 random(42);
+    std::uniform_int_distribution<long> coordinate(-50, 50);
+
+    CellSet set;
+    std::set<GridCell> expected;
+    for (int i = 0; i < 20'000; ++i) {
+        GridCell cell{coordinate(random), coordinate(random)};
+        if (random() % 3 == 0) {
+            ASSERT_EQ(set.erase(cell), expected.erase(cell) == 1);
+        } else {
+            ASSERT_EQ(set.insert(cell), expected.insert(cell).second);
+        }
+        ASSERT_EQ(set.size(), expected.size());
+    }
+
+    for (const auto &cell: expected) {
+        ASSERT_TRUE(set.contains(cell));
+    }
+
+    std::set<GridCell> iterated;
+    set.for_each([&iterated](const GridCell &cell) {
+        iterated.insert(cell);
+    });
+    ASSERT_EQ(iterated, expected);
+}
+
+TEST(CellMap, values) {
+    CellMap<long> map;
+    for (long i = 0; i < 1000; ++i) {
+        map[GridCell{i, -i}] += i;
+        map[GridCell{i, -i}] += 1;
+    }
+    ASSERT_EQ(map.size(), 1000);
+    ASSERT_EQ(*map.find(GridCell{10, -10}), 11);
+    ASSERT_EQ(map.find(GridCell{10, 10}), nullptr);
+
+    for (long i = 0; i < 1000; i += 2) {
+        ASSERT_TRUE(map.erase(GridCell{i, -i}));
+    }
+    ASSERT_EQ(map.size(), 500);
+
+    long sum = 0;
+    map.for_each([&sum](const GridCell &cell, long &value) {
+        ASSERT_EQ(value, cell.row + 1);
+        sum += value;
+    });
+    ASSERT_EQ(sum, 250'500);
+
+    map.clear();
+    ASSERT_TRUE(map.empty());
+    ASSERT_FALSE(map.contains(GridCell{1, -1}));
+}
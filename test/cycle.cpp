@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../src/solutions/cycle.h"
+
+TEST(cycle, find_cycle) {
+    // 0 -> 1 -> 2 -> 3 -> 4 -> 5 -> 3 -> ...
+    auto step = [](const int& state) { return state == 5 ? 3 : state + 1; };
+    auto key = [](const int& state) { return state; };
+
+    auto cycle = find_cycle(0, step, key, 100);
+    ASSERT_TRUE(cycle.has_value());
+    ASSERT_EQ(cycle->start, 3);
+    ASSERT_EQ(cycle->length, 3);
+
+    ASSERT_EQ(cycle->equivalent_step(2), 2);
+    ASSERT_EQ(cycle->equivalent_step(6), 3);
+    ASSERT_EQ(cycle->equivalent_step(1'000'000'001), 5);
+
+    // Fixed point right away
+    auto fixed = find_cycle(7, [](const int& state) { return state; }, key, 10);
+    ASSERT_EQ(fixed->start, 0);
+    ASSERT_EQ(fixed->length, 1);
+
+    // No cycle within the limit
+    ASSERT_FALSE(find_cycle(0, [](const int& state) { return state + 1; }, key, 1000).has_value());
+
+    // Colliding keys are confirmed by comparing the states
+    auto collision = find_cycle(0, step, [](const int& state) { return state % 2; }, 100);
+    ASSERT_EQ(collision->start, 3);
+    ASSERT_EQ(collision->length, 3);
+}
+
+TEST(cycle, fast_forward) {
+    // Linear congruential sequence, the reference is computed step by step
+    auto step = [](const long& state) { return (state * 31 + 7) % 1000; };
+    auto key = [](const long& state) { return state; };
+
+    for (std::size_t steps: {0ul, 1ul, 17ul, 250ul, 4321ul}) {
+        long expected = 5;
+        for (std::size_t i = 0; i < steps; ++i) expected = step(expected);
+        ASSERT_EQ(fast_forward(5l, step, key, steps), expected);
+    }
+
+    // The key may project a richer state
+    auto rotate = [](const std::string& state) { return state.substr(1) + state[0]; };
+    ASSERT_EQ(fast_forward(std::string("abcde"), rotate, [](const std::string& s) { return s; }, 1'000'000'002), "cdeab");
+}
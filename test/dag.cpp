@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+
+#include "../src/solutions/dag.h"
+
+enum TestOp {
+    ADD,
+    MULTIPLY,
+};
+
+static long apply_test_op(int op, long a, long b) {
+    return op == ADD ? a + b : a * b;
+}
+
+TEST(Dag, evaluatesInTopologicalOrder) {
+    // 0 = 1 * 2, 1 = 2 + 3, 2 = 3 + 1, 3 = 4
+    std::vector<DagNode<long>> nodes = {
+            {MULTIPLY, {1, 2}},
+            {ADD, {2, 3}},
+            {ADD, {3, DAG_CONSTANT}, {0, 1}},
+            {ADD, {DAG_CONSTANT, DAG_CONSTANT}, {4, 0}},
+    };
+    auto dag = DagEvaluator<long, decltype(&apply_test_op)>(nodes, &apply_test_op);
+
+    ASSERT_EQ(dag.value(3), 4);
+    ASSERT_EQ(dag.value(2), 5);
+    ASSERT_EQ(dag.value(1), 9);
+    ASSERT_EQ(dag.value(0), 45);
+}
+
+TEST(Dag, cycleThrows) {
+    std::vector<DagNode<long>> nodes = {
+            {ADD, {1, DAG_CONSTANT}},
+            {ADD, {2, DAG_CONSTANT}},
+            {ADD, {0, DAG_CONSTANT}},
+    };
+    ASSERT_THROW((DagEvaluator<long, decltype(&apply_test_op)>(nodes, &apply_test_op)), std::logic_error);
+}
+
+TEST(Dag, overrideOnlyRecomputesDownstream) {
+    long calls = 0;
+    auto counting = [&calls](int op, long a, long b) {
+        calls++;
+        return apply_test_op(op, a, b);
+    };
+
+    // Two independent chains 0 -> 1 -> 2 and 3 -> 4 -> 5, each adding 1
+    std::vector<DagNode<long>> nodes = {
+            {ADD, {DAG_CONSTANT, DAG_CONSTANT}, {10, 0}},
+            {ADD, {0, DAG_CONSTANT}, {0, 1}},
+            {ADD, {1, DAG_CONSTANT}, {0, 1}},
+            {ADD, {DAG_CONSTANT, DAG_CONSTANT}, {20, 0}},
+            {ADD, {3, DAG_CONSTANT}, {0, 1}},
+            {ADD, {4, DAG_CONSTANT}, {0, 1}},
+    };
+    auto dag = DagEvaluator<long, decltype(counting)>(nodes, counting);
+    ASSERT_EQ(calls, 6);
+
+    calls = 0;
+    dag.override_value(1, 100);
+    ASSERT_EQ(calls, 1);
+    ASSERT_EQ(dag.value(2), 101);
+    ASSERT_EQ(dag.value(5), 22);
+
+    // Changing the input of an overridden node does not reach past it
+    calls = 0;
+    dag.override_value(0, 50);
+    ASSERT_EQ(calls, 0);
+    ASSERT_EQ(dag.value(2), 101);
+
+    dag.clear_override(1);
+    ASSERT_EQ(dag.value(1), 51);
+    ASSERT_EQ(dag.value(2), 52);
+}
+
+TEST(Dag, incrementalMatchesFullEvaluation) {
+    std::mt19937 random(3);
+    const long node_count = 500;
+
+    // Every node reads up to two earlier nodes, shuffled so the ids are not in topological order
+    std::vector<long> ids(node_count);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::shuffle(ids.begin(), ids.end(), random);
+
+    std::vector<DagNode<long>> nodes(node_count);
+    for (long i = 0; i < node_count; ++i) {
+        auto& node = nodes[ids[i]];
+        node.op = (int)(random() % 2);
+        for (std::size_t slot = 0; slot < 2; ++slot) {
+            if (i > 0 && random() % 4 != 0) node.inputs[slot] = ids[random() % i];
+            else node.constants[slot] = (long)(random() % 3);
+        }
+    }
+
+    auto modular = [](int op, long a, long b) { return apply_test_op(op, a, b) % 1'000'003; };
+    auto incremental = DagEvaluator<long, decltype(modular)>(nodes, modular);
+    auto full = DagEvaluator<long, decltype(modular)>(nodes, modular);
+
+    for (int round = 0; round < 50; ++round) {
+        long node = (long)(random() % node_count);
+        long value = (long)(random() % 100);
+        incremental.override_value(node, value);
+        full.override_value(node, value);
+        full.evaluate();
+    }
+    for (long node = 0; node < node_count; ++node) {
+        ASSERT_EQ(incremental.value(node), full.value(node));
+    }
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../src/solutions/delta_stepping.h"
+#include "../src/solutions/Graph.h"
+
+TEST(delta_stepping, matchesDijkstra) {
+    std::mt19937 random(11);
+    auto graph = Graph(2000);
+    for (int i = 0; i < 10000; ++i) {
+        long source = (long)(random() % 2000);
+        long destination = (long)(random() % 2000);
+        if (source == destination) continue;
+        graph.add_directed_edge(source, (long)(random() % 100), destination);
+    }
+    auto csr = CsrGraph(graph);
+    auto expected = graph.dijkstra(3);
+
+    for (unsigned threads: {1u, 2u, 4u, 7u}) {
+        for (long delta: {0l, 1l, 10l, 1000l}) {
+            ASSERT_EQ(delta_stepping_distances(csr, 3, delta, threads), expected);
+        }
+    }
+    ASSERT_EQ(delta_stepping_distances(graph, 3), expected);
+}
+
+TEST(delta_stepping, unreachable) {
+    auto graph = Graph(3);
+    graph.add_directed_edge(0, 5, 1);
+    auto distances = delta_stepping_distances(graph, 0, 0, 3);
+    ASSERT_EQ(distances, (std::vector<long>{0, 5, std::numeric_limits<long>::max()}));
+}
+
+TEST(delta_stepping, bucketRingStaysSmall) {
+    // Long chain of heavy edges, distances end up far past the number of buckets
+    auto graph = Graph(5000);
+    std::mt19937 random(5);
+    for (long node = 1; node < 5000; ++node) {
+        graph.add_directed_edge(node - 1, 1'000'000 + (long)(random() % 1000), node);
+        if (node % 7 == 0) graph.add_directed_edge(node - 7, 3'000'000, node);
+    }
+    auto expected = graph.dijkstra(0);
+    for (unsigned threads: {1u, 3u}) {
+        ASSERT_EQ(delta_stepping_distances(graph, 0, 1000, threads), expected);
+        ASSERT_EQ(delta_stepping_distances(graph, 0, 0, threads), expected);
+    }
+
+    // One bucket per unit of weight would need a billion of them
+    auto heavy = Graph(2);
+    heavy.add_directed_edge(0, 1'000'000'000, 1);
+    ASSERT_THROW(delta_stepping_distances(heavy, 0, 1, 2), std::logic_error);
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <random>
 
 #include "../src/solutions/Graph.h"
 
@@ -50,4 +51,171 @@ TEST(Graph, dijkstraSimpleDirected) {
     ASSERT_EQ(distances[3], 20);
     ASSERT_EQ(distances[4], 26);
     ASSERT_EQ(distances[5], 11);
-}
\ No newline at end of file
+}
+
+TEST(Graph, csrMatchesAdjacencyLists) {
+    auto graph = Graph(6);
+    graph.add_directed_edge(0, 14, 5);
+    graph.add_directed_edge(0, 9, 2);
+    graph.add_directed_edge(0, 7, 1);
+    graph.add_directed_edge(1, 10, 2);
+    graph.add_directed_edge(1, 15, 3);
+    graph.add_directed_edge(2, 2, 5);
+    graph.add_directed_edge(2, 11, 3);
+    graph.add_directed_edge(3, 6, 4);
+    graph.add_directed_edge(4, 9, 5);
+
+    auto csr = CsrGraph(graph);
+    ASSERT_EQ(csr.size(), 6);
+    ASSERT_EQ(csr.edge_count(), 9);
+    ASSERT_EQ(csr.edges_of(0).size(), 3);
+    ASSERT_EQ(csr.edges_of(5).size(), 0);
+    ASSERT_EQ(csr.edges_of(2)[1].destination, 3);
+    ASSERT_EQ(csr.edges_of(2)[1].weight, 11);
+
+    for (long start = 0; start < 6; ++start) {
+        ASSERT_EQ(csr.dijkstra(start), graph.dijkstra(start));
+    }
+    ASSERT_EQ(csr.dijkstra_with_path(0, 4), (std::vector<long>{0, 2, 3, 4}));
+    ASSERT_EQ(csr.dijkstra_with_path(0, 4), graph.dijkstra_with_path(0, 4));
+    ASSERT_EQ(csr.dijkstra_with_path(5, 0), (std::vector<long>{0}));
+
+    auto negative = Graph(2);
+    negative.add_directed_edge(0, -1, 1);
+    ASSERT_THROW(CsrGraph{negative}, std::logic_error);
+}
+
+TEST(Graph, dialMatchesHeap) {
+    std::mt19937 random(42);
+    for (long max_weight: {0l, 1l, 9l, 256l}) {
+        auto graph = Graph(300);
+        for (int i = 0; i < 1500; ++i) {
+            long source = (long)(random() % 300);
+            long destination = (long)(random() % 300);
+            if (source == destination) continue;
+            graph.add_directed_edge(source, (long)(random() % (max_weight + 1)), destination);
+        }
+
+        auto expected = heap_search(graph, {0}).distances;
+        auto parents = dial_search(graph, {0}, max_weight).parents;
+        ASSERT_EQ(dial_search(graph, {0}, max_weight).distances, expected);
+        ASSERT_EQ(graph.dijkstra(0), expected);
+        ASSERT_EQ(CsrGraph(graph).dijkstra(0), expected);
+
+        // Parents may differ on ties, but always lie on a shortest path
+        for (long node = 1; node < 300; ++node) {
+            if (parents[node] == -1) continue;
+            bool tight = false;
+            for (const auto& edge: graph.edges_of(parents[node])) {
+                tight |= edge.destination == node && expected[parents[node]] + edge.weight == expected[node];
+            }
+            ASSERT_TRUE(tight);
+        }
+    }
+}
+
+TEST(Graph, multiSource) {
+    // 0 - 1 - 2 - 3 - 4 - 5 in a line, 5 -> 6 one way
+    auto graph = Graph(7);
+    for (long node = 0; node < 5; ++node) {
+        graph.add_undirected_edge(node, 10, node + 1);
+    }
+    graph.add_directed_edge(5, 1000, 6);
+
+    for (const auto& paths: {heap_search(graph, {0, 4}), shortest_paths(CsrGraph(graph), {0, 4})}) {
+        ASSERT_EQ(paths.distances, (std::vector<long>{0, 10, 20, 10, 0, 10, 1010}));
+        ASSERT_EQ(paths.nearest_sources, (std::vector<long>{0, 0, 0, 4, 4, 4, 4}));
+        ASSERT_EQ(paths.parents[6], 5);
+        ASSERT_EQ(paths.parents[4], -1);
+    }
+
+    // Distance from any of {0, 2} to 6 in one search
+    auto reversed = graph.reversed();
+    auto to_target = reversed.dijkstra(6);
+    ASSERT_EQ(std::min(to_target[0], to_target[2]), 1030);
+    ASSERT_EQ(reversed.edges_of(6).size(), 1);
+    ASSERT_EQ(reversed.edges_of(5).size(), 1);
+
+    auto csr_reversed = CsrGraph(graph).reversed();
+    ASSERT_EQ(csr_reversed.dijkstra(6), to_target);
+    ASSERT_EQ(csr_reversed.edges_of(6).size(), 1);
+    ASSERT_EQ(csr_reversed.edges_of(6)[0].destination, 5);
+}
+
+TEST(Graph, targetedSearches) {
+    std::mt19937 random(7);
+    auto graph = Graph(400);
+    for (int i = 0; i < 1200; ++i) {
+        long source = (long)(random() % 400);
+        long destination = (long)(random() % 400);
+        if (source == destination) continue;
+        graph.add_undirected_edge(source, 1 + (long)(random() % 1000), destination);
+    }
+    auto csr = CsrGraph(graph);
+
+    // One workspace for all the queries
+    SearchWorkspace workspace(graph.size());
+    for (long source = 0; source < 400; source += 37) {
+        auto expected = heap_search(graph, {source}).distances;
+        for (long target = 0; target < 400; target += 13) {
+            ASSERT_EQ(shortest_distance(csr, source, target, workspace), expected[target]);
+            ASSERT_EQ(bidirectional_distance(csr, source, target, workspace), expected[target]);
+
+            auto path = bidirectional_path(graph, source, target, workspace);
+            if (expected[target] == std::numeric_limits<long>::max()) {
+                ASSERT_TRUE(path.empty());
+                continue;
+            }
+            ASSERT_EQ(path.front(), source);
+            ASSERT_EQ(path.back(), target);
+
+            // The path is made of real edges and adds up to the distance
+            long length = 0;
+            for (std::size_t i = 1; i < path.size(); ++i) {
+                long best_edge = std::numeric_limits<long>::max();
+                for (const auto& edge: graph.edges_of(path[i - 1])) {
+                    if (edge.destination == path[i]) best_edge = std::min(best_edge, edge.weight);
+                }
+                ASSERT_NE(best_edge, std::numeric_limits<long>::max());
+                length += best_edge;
+            }
+            ASSERT_EQ(length, expected[target]);
+            ASSERT_EQ(dijkstra_path(csr, source, target, workspace).front(), source);
+        }
+    }
+}
+
+TEST(Graph, bfsMatchesHeap) {
+    std::mt19937 random(3);
+    // Sparse and dense enough to go bottom-up, directed so the reversed edges matter
+    for (int edges: {600, 20000}) {
+        auto graph = Graph(1000);
+        for (int i = 0; i < edges; ++i) {
+            long source = (long)(random() % 1000);
+            long destination = (long)(random() % 1000);
+            if (source == destination) continue;
+            graph.add_directed_edge(source, 3, destination);
+        }
+        ASSERT_EQ(graph.min_edge_weight(), 3);
+        ASSERT_EQ(graph.max_edge_weight(), 3);
+
+        const std::vector<long> sources = {0, 17, 17, 500};
+        auto expected = heap_search(graph, sources);
+        long bottom_up_levels = -1;
+        auto direction_optimised = bfs_search(graph, sources, 3, &bottom_up_levels);
+        // The dense graph must actually take the bottom-up path, the sparse one never spreads enough
+        if (edges == 20000) ASSERT_GT(bottom_up_levels, 0);
+        else ASSERT_EQ(bottom_up_levels, 0);
+
+        for (const auto& paths: {direction_optimised, bfs_search(CsrGraph(graph), sources, 3)}) {
+            ASSERT_EQ(paths.distances, expected.distances);
+            for (long node = 0; node < 1000; ++node) {
+                if (paths.parents[node] == -1) continue;
+                // Parents are one step closer and lead back to the same kind of source
+                ASSERT_EQ(paths.distances[paths.parents[node]] + 3, paths.distances[node]);
+                ASSERT_EQ(paths.nearest_sources[node], paths.nearest_sources[paths.parents[node]]);
+            }
+        }
+        ASSERT_EQ(graph.dijkstra(0), heap_search(graph, {0}).distances);
+    }
+}
@@ -169,4 +169,259 @@ TEST(grid, rotate_cw) {
     ASSERT_EQ(grid_uneven.at({1, 0}), '6');
     ASSERT_EQ(grid_uneven.at({1, 1}), '4');
     ASSERT_EQ(grid_uneven.at({1, 2}), '2');
-}
\ No newline at end of file
+}
+
+TEST(grid, grow_all_edges) {
+    auto grid = make_grid("12\n34\n");
+
+    for (int i = 0; i < 50; ++i) {
+        grid.add_row('v');
+        grid.add_row_start('^');
+        grid.add_column_start('<');
+        grid.add_column(std::string(grid.rows, '>'));
+    }
+
+    ASSERT_EQ(grid.rows, 102);
+    ASSERT_EQ(grid.columns, 102);
+    ASSERT_EQ(grid.origin, (GridCell{50, 50}));
+
+    // The original cells moved by exactly the origin
+    ASSERT_EQ(grid.at(GridCell{0, 0} + grid.origin), '1');
+    ASSERT_EQ(grid.at(GridCell{0, 1} + grid.origin), '2');
+    ASSERT_EQ(grid.at(GridCell{1, 0} + grid.origin), '3');
+    ASSERT_EQ(grid.at(GridCell{1, 1} + grid.origin), '4');
+
+    ASSERT_EQ(grid.at({0, 0}), '<');
+    ASSERT_EQ(grid.at({0, 101}), '>');
+    ASSERT_EQ(grid.at({0, 50}), '^');
+    ASSERT_EQ(grid.at({101, 50}), 'v');
+
+    // Slack is never exposed
+    auto packed = grid.packed_data();
+    ASSERT_EQ(packed.size(), 102 * 102);
+    ASSERT_EQ(packed.find('\0'), std::string::npos);
+
+    grid.shrink_to_fit();
+    ASSERT_EQ(grid.data, packed);
+    ASSERT_EQ(grid.at(GridCell{1, 1} + grid.origin), '4');
+}
+
+TEST(grid, default_constructed_is_empty) {
+    Grid grid;
+    ASSERT_EQ(grid.rows, 0);
+    ASSERT_EQ(grid.columns, 0);
+    ASSERT_FALSE(grid.contains({0, 0}));
+
+    grid.add_column_start("");
+    grid.add_row(".");
+    grid.add_row("#");
+    ASSERT_EQ(grid.packed_data(), ".#");
+}
+
+TEST(grid, reserve_keeps_cells) {
+    auto grid = make_grid("ab\ncd\n");
+    grid.reserve(3, 1, 2, 5);
+
+    ASSERT_EQ(grid.leading_rows, 3);
+    ASSERT_EQ(grid.leading_columns, 2);
+    ASSERT_EQ(grid.stride, 9);
+    ASSERT_EQ(grid.at({0, 0}), 'a');
+    ASSERT_EQ(grid.at({1, 1}), 'd');
+    ASSERT_EQ(grid.at({2, 0}), '\0');
+    ASSERT_EQ(grid.packed_data(), "abcd");
+    ASSERT_EQ(draw_grid_to_string(grid), "ab\ncd\n");
+
+    grid.rotate_cw();
+    ASSERT_EQ(grid.packed_data(), "cadb");
+}
+
+TEST(grid, sentinel_border) {
+    auto grid = make_grid("12\n34\n");
+    grid.set_sentinel_border('#');
+
+    ASSERT_EQ(grid.at_unchecked({0, 0}), '1');
+    ASSERT_EQ(grid.at_unchecked({1, 1}), '4');
+    for (long i = -1; i <= 2; ++i) {
+        ASSERT_EQ(grid.at_unchecked({-1, i}), '#');
+        ASSERT_EQ(grid.at_unchecked({2, i}), '#');
+        ASSERT_EQ(grid.at_unchecked({i, -1}), '#');
+        ASSERT_EQ(grid.at_unchecked({i, 2}), '#');
+    }
+    // Checked access is unaffected
+    ASSERT_EQ(grid.at({-1, 0}), '\0');
+    ASSERT_EQ(grid.packed_data(), "1234");
+
+    // The halo follows the grid when it grows
+    grid.add_row("56");
+    grid.add_column_start("abc");
+    ASSERT_EQ(grid.packed_data(), "a12b34c56");
+    for (long i = -1; i <= 3; ++i) {
+        ASSERT_EQ(grid.at_unchecked({-1, i}), '#');
+        ASSERT_EQ(grid.at_unchecked({3, i}), '#');
+        ASSERT_EQ(grid.at_unchecked({i, -1}), '#');
+        ASSERT_EQ(grid.at_unchecked({i, 3}), '#');
+    }
+
+    grid.set_unchecked({1, 1}, 'x');
+    ASSERT_EQ(grid.at({1, 1}), 'x');
+
+    grid.rotate_cw();
+    ASSERT_EQ(grid.at_unchecked({-1, -1}), '#');
+    ASSERT_EQ(grid.at_unchecked({3, 3}), '#');
+}
+
+TEST(grid, find) {
+    auto grid = make_grid("..S.\n.S..\n...S\n");
+
+    ASSERT_EQ(grid.find_first('S'), (GridCell{0, 2}));
+    ASSERT_THROW((void)grid.find_first('E'), std::out_of_range);
+
+    auto all = grid.find_all('S');
+    ASSERT_EQ(all.size(), 3);
+    ASSERT_EQ(all[0], (GridCell{0, 2}));
+    ASSERT_EQ(all[1], (GridCell{1, 1}));
+    ASSERT_EQ(all[2], (GridCell{2, 3}));
+    ASSERT_TRUE(grid.find_all('E').empty());
+
+    // Slack never matches
+    grid.set_sentinel_border('S');
+    ASSERT_EQ(grid.find_all('S').size(), 3);
+}
+
+TEST(grid, make_grid) {
+    auto grid = make_grid("\n\nab\r\ncd\r\nef\n\n");
+    ASSERT_EQ(grid.rows, 3);
+    ASSERT_EQ(grid.columns, 2);
+    ASSERT_EQ(grid.packed_data(), "abcdef");
+
+    auto single = make_grid("abc");
+    ASSERT_EQ(single.rows, 1);
+    ASSERT_EQ(single.columns, 3);
+
+    ASSERT_THROW(make_grid("ab\nc\n"), std::logic_error);
+    ASSERT_THROW(make_grid("\n \n"), std::logic_error);
+}
+
+TEST(grid, make_grid_view) {
+    std::string input = "\nS.\r\n.E\r\n";
+    auto view = make_grid_view(input);
+
+    ASSERT_EQ(view.rows, 2);
+    ASSERT_EQ(view.columns, 2);
+    ASSERT_EQ(view.stride, 4);
+    ASSERT_EQ(view.at({0, 0}), 'S');
+    ASSERT_EQ(view.at({1, 1}), 'E');
+    ASSERT_EQ(view.at({1, 2}), '\0');
+    ASSERT_EQ(view.find_first('E'), (GridCell{1, 1}));
+    ASSERT_EQ(view.to_grid().packed_data(), "S..E");
+
+    ASSERT_THROW(make_grid_view("ab\r\ncd\nef"), std::logic_error);
+}
+
+TEST(grid, neighbours) {
+    auto grid = make_grid("123\n456\n789\n");
+
+    std::string corner;
+    for_each_neighbour_4(grid, {0, 0}, [&corner](const GridCell&, char value) {
+        corner += value;
+    });
+    ASSERT_EQ(corner, "24");
+
+    std::string centre;
+    for_each_neighbour_4(grid, {1, 1}, [&centre](const GridCell&, char value) {
+        centre += value;
+    });
+    ASSERT_EQ(centre, "2684");
+
+    std::string all;
+    for_each_neighbour_8(grid, {1, 1}, [&all](const GridCell&, char value) {
+        all += value;
+    });
+    ASSERT_EQ(all, "23698741");
+
+    std::vector<GridCell> edge;
+    for_each_neighbour_8(grid, {2, 1}, [&edge](const GridCell& cell, char) {
+        edge.push_back(cell);
+    });
+    ASSERT_EQ(edge.size(), 5);
+}
+
+TEST(grid, apply_stencil) {
+    auto grid = make_grid(
+            ".....\n"
+            ".###.\n"
+            ".###.\n"
+            ".....\n"
+    );
+
+    // Count of '#' in the neighbourhood, centre included
+    auto counts = apply_stencil(grid, [](const Neighbourhood& n) {
+        int count = (n.north_west == '#') + (n.north == '#') + (n.north_east == '#')
+                    + (n.west == '#') + (n.centre == '#') + (n.east == '#')
+                    + (n.south_west == '#') + (n.south == '#') + (n.south_east == '#');
+        return (char)('0' + count);
+    });
+
+    ASSERT_EQ(counts.packed_data(),
+              "12321"
+              "24642"
+              "24642"
+              "12321");
+
+    // Outside reads as the given character
+    auto single = apply_stencil(make_grid("#"), [](const Neighbourhood& n) {
+        return n.north == 'x' && n.south_east == 'x' ? n.centre : '?';
+    }, 'x');
+    ASSERT_EQ(single.packed_data(), "#");
+
+    // Nothing to visit when either side is empty
+    auto identity = [](const Neighbourhood& n) { return n.centre; };
+    for (const auto& empty: {Grid(0, 4, ""), Grid(3, 0, ""), Grid()}) {
+        auto output = apply_stencil(empty, identity);
+        ASSERT_EQ(output.rows, empty.rows);
+        ASSERT_EQ(output.columns, empty.columns);
+        ASSERT_EQ(output.packed_data(), "");
+    }
+}
+
+TEST(grid, state_hash) {
+    auto grid = make_grid(
+            "O.#\n"
+            ".O.\n"
+    );
+    auto untracked = grid;
+    grid.enable_hashing();
+    ASSERT_EQ(grid.state_hash(), untracked.state_hash());
+
+    // Incremental updates match a full recompute
+    grid.set_value({0, 0}, '.');
+    grid.set_unchecked({1, 0}, 'O');
+    untracked.set_value({0, 0}, '.');
+    untracked.set_value({1, 0}, 'O');
+    ASSERT_EQ(grid.state_hash(), untracked.state_hash());
+
+    // Writing back the original cells restores the original hash
+    auto before = make_grid("O.#\n.O.\n").state_hash();
+    grid.set_value({0, 0}, 'O');
+    grid.set_value({1, 0}, '.');
+    ASSERT_EQ(grid.state_hash(), before);
+
+    // Same cells in a different position hash differently
+    ASSERT_NE(make_grid("O.\n..\n").state_hash(), make_grid(".O\n..\n").state_hash());
+
+    // The halo and growth keep the hash consistent
+    grid.set_sentinel_border('#');
+    grid.add_row("...");
+    grid.rotate_cw();
+    ASSERT_EQ(grid.state_hash(), Grid(grid.rows, grid.columns, grid.packed_data()).state_hash());
+    ASSERT_TRUE(grid.same_cells(Grid(grid.rows, grid.columns, grid.packed_data())));
+    ASSERT_FALSE(grid.same_cells(untracked));
+
+    // Growing at the start only mixes in the new cells, the hash matches a recompute
+    grid.add_row_start('O');
+    grid.add_column_start("#.#.");
+    grid.add_column('.');
+    auto recomputed = grid;
+    recomputed.hashing = false;
+    ASSERT_EQ(grid.state_hash(), recomputed.state_hash());
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include "../src/solutions/grid_graph.h"
+
+static std::optional<long> climb(char from, char to) {
+    if (to <= from + 1) return 1;
+    return std::nullopt;
+}
+
+static std::optional<long> open_cells(char from, char to) {
+    if (from == '#' || to == '#') return std::nullopt;
+    return to - '0';
+}
+
+TEST(GridGraph, edgesFollowTheWeight) {
+    auto grid = make_grid("abc\nbcd\nxyz\n");
+    auto graph = GridGraph(grid, climb);
+
+    ASSERT_EQ(graph.size(), 9);
+    ASSERT_EQ(graph.min_edge_weight(), 1);
+    ASSERT_EQ(graph.max_edge_weight(), 1);
+
+    // a at (0, 0) can climb to both b
+    auto edges = graph.edges_of(0);
+    ASSERT_EQ(edges.size(), 2);
+    // c at (1, 1) cannot reach y, but every other neighbour
+    ASSERT_EQ(graph.edges_of((long)grid.underlying_idx({1, 1})).size(), 3);
+
+    std::size_t total = 0;
+    for (long node = 0; node < (long)graph.size(); ++node) total += graph.edges_of(node).size();
+    ASSERT_EQ(graph.edge_count(), total);
+}
+
+TEST(GridGraph, reversedFlipsEveryEdge) {
+    auto grid = make_grid("abc\nbcd\nxyz\n");
+    auto graph = GridGraph(grid, climb);
+    auto reversed = graph.reversed();
+
+    ASSERT_EQ(reversed.edge_count(), graph.edge_count());
+    for (long node = 0; node < (long)graph.size(); ++node) {
+        for (const auto& edge: graph.edges_of(node)) {
+            auto back = reversed.edges_of(edge.destination);
+            ASSERT_TRUE(std::any_of(back.begin(), back.end(), [node](const Edge& e) { return e.destination == node; }));
+        }
+    }
+}
+
+TEST(GridGraph, searchesMatchMaterialisedGraph) {
+    auto grid = make_grid("1123#\n2#1#1\n31191\n11#21\n");
+    auto grid_graph = GridGraph(grid, open_cells);
+
+    Graph graph(grid.rows * grid.columns);
+    for (long node = 0; node < (long)grid_graph.size(); ++node) {
+        for (const auto& edge: grid_graph.edges_of(node)) graph.add_directed_edge(node, edge.weight, edge.destination);
+    }
+
+    auto expected = dijkstra_distances(graph, 0);
+    ASSERT_EQ(shortest_paths(grid_graph, {0}).distances, expected);
+    ASSERT_EQ(heap_search(grid_graph, {0}).distances, expected);
+    ASSERT_EQ(dijkstra_distances(grid_graph, 0), expected);
+
+    long target = (long)grid.underlying_idx({3, 4});
+    auto path = dijkstra_path(grid_graph, 0, target);
+    ASSERT_EQ(path.front(), 0);
+    ASSERT_EQ(path.back(), target);
+}
+
+TEST(GridGraph, uniformWeightsUseBottomUpBfs) {
+    // Open grid big enough for the frontier to switch to bottom-up steps through reversed()
+    auto grid = Grid(64, 64, std::string(64 * 64, '.'));
+    auto graph = GridGraph(grid, [](char, char) { return std::optional<long>(1); });
+
+    auto paths = bfs_search(graph, {(long)grid.underlying_idx({32, 32})});
+    for (long row = 0; row < 64; ++row) {
+        for (long column = 0; column < 64; ++column) {
+            ASSERT_EQ(paths.distances[grid.underlying_idx({row, column})], std::abs(row - 32) + std::abs(column - 32));
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "../src/solutions/implicit_search.h"
+#include "../src/solutions/grid.h"
+#include "../src/solutions/Graph.h"
+
+static const Grid COSTS = make_grid(
+        "131\n"
+        "191\n"
+        "111\n"
+        "951\n"
+);
+
+// Entering a cell costs its digit
+static auto grid_successors = [](const GridCell& cell, auto emit) {
+    for_each_neighbour_4(COSTS, cell, [&emit](const GridCell& next, char value) {
+        emit(next, value - '0');
+    });
+};
+
+static auto grid_key = [](const GridCell& cell) {
+    return (uint64_t)COSTS.underlying_idx(cell);
+};
+
+TEST(implicit_search, matches_graph) {
+    Graph graph(COSTS.rows * COSTS.columns);
+    for (long row = 0; row < COSTS.rows; ++row) {
+        for (long column = 0; column < COSTS.columns; ++column) {
+            GridCell cell{row, column};
+            grid_successors(cell, [&](const GridCell& next, long cost) {
+                graph.add_directed_edge((long)COSTS.underlying_idx(cell), cost, (long)COSTS.underlying_idx(next));
+            });
+        }
+    }
+    auto distances = graph.dijkstra(0);
+
+    const GridCell goal{3, 2};
+    auto is_goal = [&goal](const GridCell& cell) { return cell == goal; };
+    auto manhattan = [&goal](const GridCell& cell) { return std::abs(goal.row - cell.row) + std::abs(goal.column - cell.column); };
+
+    // Dense Dijkstra, dense A* and hashed A*
+    auto dijkstra = implicit_search(std::vector<GridCell>{{0, 0}}, 12, grid_key, grid_successors, is_goal);
+    auto a_star = implicit_search(std::vector<GridCell>{{0, 0}}, 12, grid_key, grid_successors, is_goal, manhattan);
+    auto hashed = implicit_search(std::vector<GridCell>{{0, 0}}, 0, grid_key, grid_successors, is_goal, manhattan);
+
+    ASSERT_TRUE(dijkstra.has_value());
+    ASSERT_EQ(dijkstra->cost, distances[COSTS.underlying_idx(goal)]);
+    ASSERT_EQ(a_star->cost, dijkstra->cost);
+    ASSERT_EQ(hashed->cost, dijkstra->cost);
+    ASSERT_EQ(a_star->goal, goal);
+
+    auto unreachable = implicit_search(std::vector<GridCell>{{0, 0}}, 12, grid_key, grid_successors, [](const GridCell&) {
+        return false;
+    });
+    ASSERT_FALSE(unreachable.has_value());
+}
+
+TEST(implicit_search, run_length_rules) {
+    // A corridor where moving straight more than twice in a row is not allowed
+    typedef struct Walker {
+        long position;
+        int run;
+    } Walker;
+
+    auto key = [](const Walker& walker) { return (uint64_t)(walker.position * 3 + walker.run); };
+    auto successors = [](const Walker& walker, auto emit) {
+        // Straight costs 1, a "turn" stays in place, costs 5 and resets the run
+        if (walker.run < 2) emit(Walker{walker.position + 1, walker.run + 1}, 1);
+        emit(Walker{walker.position, 0}, 5);
+    };
+    auto is_goal = [](const Walker& walker) { return walker.position == 6; };
+
+    auto result = implicit_search(std::vector<Walker>{{0, 0}}, 7 * 3, key, successors, is_goal);
+    ASSERT_TRUE(result.has_value());
+    // 6 steps in runs of 2, with two resets in between
+    ASSERT_EQ(result->cost, 6 + 2 * 5);
+}
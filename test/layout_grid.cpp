@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "../src/solutions/layout_grid.h"
+#include "../src/solutions/regions.h"
+#include "../src/solutions/tilt.h"
+
+template<typename Layout>
+static void check_layout() {
+    // Not a multiple of the tile size and not square
+    const long rows = 21;
+    const long columns = 13;
+    std::string cells;
+    for (long i = 0; i < rows * columns; ++i) {
+        cells += (char)('a' + i % 23);
+    }
+    Grid grid{(std::size_t)rows, (std::size_t)columns, cells};
+
+    auto layout_grid = make_layout_grid<Layout>(grid);
+    for (long row = 0; row < rows; ++row) {
+        for (long column = 0; column < columns; ++column) {
+            ASSERT_EQ(layout_grid.at({row, column}), grid.at({row, column}));
+        }
+    }
+    ASSERT_EQ(layout_grid.at({rows, 0}), '\0');
+    ASSERT_EQ(layout_grid.at({0, -1}), '\0');
+    ASSERT_EQ(layout_grid.to_grid().packed_data(), cells);
+}
+
+TEST(LayoutGrid, layouts) {
+    check_layout<RowMajorLayout>();
+    check_layout<TiledLayout>();
+    check_layout<MortonLayout>();
+
+    ASSERT_EQ(MortonLayout(3, 5).size(), 64);
+    ASSERT_EQ(MortonLayout(3, 5).index({1, 2}), 0b0110);
+    ASSERT_EQ(TiledLayout(9, 9).size(), 4 * 64);
+}
+
+TEST(LayoutGrid, algorithms) {
+    auto grid = make_grid(
+            "O.#.\n"
+            "..O.\n"
+            "O#.O\n"
+            ".O..\n"
+    );
+    auto morton = make_layout_grid<MortonLayout>(grid);
+
+    tilt(morton, NEIGHBOURS_4[0]);
+    flood_fill(morton, {3, 3}, '~');
+    tilt(grid, NEIGHBOURS_4[0]);
+    flood_fill(grid, {3, 3}, '~');
+    ASSERT_EQ(morton.to_grid().packed_data(), grid.packed_data());
+}
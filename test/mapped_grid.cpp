@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include "../src/solutions/mapped_grid.h"
+#include "../src/solutions/regions.h"
+#include "../src/solutions/tilt.h"
+
+static std::string temp_path(const std::string &name) {
+    return (std::filesystem::temp_directory_path() / ("aoc-mapped-grid-" + name)).string();
+}
+
+TEST(MappedGrid, cells) {
+    auto path = temp_path("cells");
+    {
+        // Spans several tiles in both directions, with partial tiles at the edges
+        auto grid = make_mapped_grid(path, 150, 70, '.');
+        ASSERT_EQ(grid.at({0, 0}), '.');
+        ASSERT_EQ(grid.at({149, 69}), '.');
+        ASSERT_EQ(grid.at({150, 0}), '\0');
+        ASSERT_EQ(grid.at({0, -1}), '\0');
+
+        grid.set_unchecked({149, 69}, 'x');
+        grid.set_unchecked({64, 63}, 'y');
+        grid.advise_rows(0, 150, MappedGrid::ADVICE_DONE);
+        grid.sync();
+    }
+
+    auto reopened = open_mapped_grid(path, 150, 70);
+    ASSERT_EQ(reopened.at({149, 69}), 'x');
+    ASSERT_EQ(reopened.at({64, 63}), 'y');
+    ASSERT_EQ(reopened.at({64, 64}), '.');
+    ASSERT_THROW(open_mapped_grid(path, 500, 500), std::logic_error);
+
+    std::filesystem::remove(path);
+}
+
+TEST(MappedGrid, algorithms) {
+    auto in_path = temp_path("in.txt");
+    auto path = temp_path("algorithms");
+    auto out_path = temp_path("out.txt");
+    {
+        std::ofstream in(in_path);
+        in << "O.#.\r\n"
+              "..O.\r\n"
+              "O#.O\r\n"
+              ".O..\r\n";
+    }
+
+    auto grid = make_mapped_grid(in_path, path);
+    ASSERT_EQ(grid.rows, 4);
+    ASSERT_EQ(grid.columns, 4);
+
+    ASSERT_EQ(tilt(grid, NEIGHBOURS_4[0]), 2);
+    ASSERT_EQ(flood_fill(grid, {3, 3}, '~'), 5);
+
+    write_mapped_grid(grid, out_path);
+    std::ifstream out(out_path);
+    std::string text((std::istreambuf_iterator<char>(out)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(text,
+              "O.#O\n"
+              "O.O~\n"
+              ".#~~\n"
+              ".O~~\n");
+
+    std::filesystem::remove(in_path);
+    std::filesystem::remove(path);
+    std::filesystem::remove(out_path);
+}
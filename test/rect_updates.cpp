@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include "../src/solutions/rect_updates.h"
+
+static std::vector<RectUpdate> random_updates(std::mt19937 &random, int count, long size) {
+    std::uniform_int_distribution<long> coordinate(0, size - 1);
+    std::vector<RectUpdate> updates;
+    for (int i = 0; i < count; ++i) {
+        updates.push_back(RectUpdate{
+                (RectOperation)(random() % 3),
+                {coordinate(random), coordinate(random)},
+                {coordinate(random), coordinate(random)},
+        });
+    }
+    return updates;
+}
+
+TEST(RectUpdates, difference_grid) {
+    DifferenceGrid grid(3, 4);
+    grid.add({0, 0}, {2, 3}, 1);
+    grid.add({1, 1}, {2, 2}, 5);
+    grid.add({2, 3}, {10, 10}, -2);
+
+    std::vector<long> expected = {
+            1, 1, 1, 1,
+            1, 6, 6, 1,
+            1, 6, 6, -1,
+    };
+    ASSERT_EQ(grid.resolve(), expected);
+    ASSERT_EQ(grid.sum(), 30);
+}
+
+TEST(RectUpdates, count_set_cells) {
+    // The 2015/06 example
+    std::vector<RectUpdate> updates = {
+            {RECT_SET, {0, 0}, {999, 999}},
+            {RECT_TOGGLE, {0, 0}, {999, 0}},
+            {RECT_RESET, {499, 499}, {500, 500}},
+    };
+    ASSERT_EQ(count_set_cells(updates), 998'996);
+    ASSERT_EQ(count_set_cells({}), 0);
+}
+
+TEST(RectUpdates, matches_brute_force) {
+    std::mt19937 random(2015);
+    const long size = 40;
+
+    for (int round = 0; round < 20; ++round) {
+        auto updates = random_updates(random, 30, size);
+
+        std::vector<bool> lights(size * size, false);
+        std::vector<long> brightness(size * size, 0);
+        for (const auto &update: updates) {
+            for (long row = std::min(update.from.row, update.to.row); row <= std::max(update.from.row, update.to.row); ++row) {
+                for (long column = std::min(update.from.column, update.to.column); column <= std::max(update.from.column, update.to.column); ++column) {
+                    auto idx = row * size + column;
+                    switch (update.operation) {
+                        case RECT_SET: lights[idx] = true; brightness[idx] += 1; break;
+                        case RECT_RESET: lights[idx] = false; brightness[idx] = std::max(0l, brightness[idx] - 1); break;
+                        case RECT_TOGGLE: lights[idx] = !lights[idx]; brightness[idx] += 2; break;
+                    }
+                }
+            }
+        }
+
+        ASSERT_EQ(count_set_cells(updates), std::count(lights.begin(), lights.end(), true));
+
+        auto total_brightness = sweep_rectangles<long>(updates, [](long &value, const RectUpdate &update) {
+            if (update.operation == RECT_SET) value += 1;
+            if (update.operation == RECT_RESET) value = std::max(0l, value - 1);
+            if (update.operation == RECT_TOGGLE) value += 2;
+        }, [](long value) {
+            return value;
+        });
+        ASSERT_EQ(total_brightness, std::accumulate(brightness.begin(), brightness.end(), 0l));
+    }
+}
+
+TEST(RectUpdates, many_rows) {
+    // More than 64 compressed rows so the bitset spans several words
+    std::vector<RectUpdate> updates;
+    for (long i = 0; i < 200; ++i) {
+        updates.push_back({RECT_TOGGLE, {i * 3, 0}, {i * 3 + 500, 9}});
+    }
+
+    long expected = sweep_rectangles<char>(updates, [](char &value, const RectUpdate &) {
+        value = !value;
+    }, [](char value) {
+        return (long)value;
+    });
+    ASSERT_EQ(count_set_cells(updates), expected);
+    ASSERT_GT(expected, 0);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../src/solutions/regions.h"
+
+TEST(Regions, flood_fill) {
+    auto grid = make_grid(
+            "..#..\n"
+            ".##..\n"
+            "#..#.\n"
+            "..#..\n"
+    );
+
+    ASSERT_EQ(flood_fill(grid, {0, 4}, 'o'), 7);
+    ASSERT_EQ(grid.packed_data(),
+              "..#oo"
+              ".##oo"
+              "#..#o"
+              "..#oo");
+
+    // Walls only connect orthogonally
+    ASSERT_EQ(flood_fill(grid, {0, 0}, 'x'), 3);
+    ASSERT_EQ(flood_fill(grid, {0, 0}, 'x'), 0);
+    ASSERT_EQ(flood_fill(grid, {5, 5}, 'x'), 0);
+}
+
+TEST(Regions, flood_fill_spiral) {
+    // Needs seeds in both directions of the scanline
+    auto grid = make_grid(
+            "#######\n"
+            "#.....#\n"
+            "#.###.#\n"
+            "#.#.#.#\n"
+            "#.#...#\n"
+            "#.#####\n"
+            "#......\n"
+    );
+
+    ASSERT_EQ(flood_fill(grid, {3, 3}, 'o'), 21);
+    ASSERT_EQ(grid.find_all('.').size(), 0);
+}
+
+TEST(Regions, label_regions) {
+    auto grid = make_grid(
+            "AAAA\n"
+            "BBCD\n"
+            "BBCC\n"
+            "EEEC\n"
+    );
+
+    auto regions = label_regions(grid);
+    ASSERT_EQ(regions.regions.size(), 5);
+
+    ASSERT_EQ(regions.at({0, 0}), 0);
+    ASSERT_EQ(regions.at({2, 1}), 1);
+    ASSERT_EQ(regions.at({3, 3}), 2);
+    ASSERT_EQ(regions.at({1, 3}), 3);
+    ASSERT_EQ(regions.at({3, 0}), 4);
+    ASSERT_EQ(regions.at({4, 0}), -1);
+
+    std::vector<std::pair<std::size_t, std::size_t>> expected = {
+            {4, 10}, {4, 8}, {4, 10}, {1, 4}, {3, 8},
+    };
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(regions.regions[i].size, expected[i].first);
+        ASSERT_EQ(regions.regions[i].perimeter, expected[i].second);
+    }
+    ASSERT_EQ(regions.regions[2].value, 'C');
+    ASSERT_EQ(regions.regions[2].first_cell, (GridCell{1, 2}));
+
+    auto skipped = label_regions(grid, 'B');
+    ASSERT_EQ(skipped.regions.size(), 4);
+    ASSERT_EQ(skipped.at({1, 0}), -1);
+}
+
+TEST(Regions, label_regions_parallel) {
+    std::mt19937 random(7);
+    std::string input;
+    for (int row = 0; row < 97; ++row) {
+        for (int column = 0; column < 61; ++column) {
+            input += (random() % 3 == 0) ? '#' : '.';
+        }
+        input += '\n';
+    }
+    auto grid = make_grid(input);
+
+    auto single = label_regions(grid, '#', 1);
+    for (unsigned threads: {2u, 3u, 8u, 200u}) {
+        auto parallel = label_regions(grid, '#', threads);
+        ASSERT_EQ(parallel.labels, single.labels);
+        ASSERT_EQ(parallel.regions.size(), single.regions.size());
+    }
+
+    // Labels agree with flood filling
+    for (std::size_t label = 0; label < single.regions.size(); ++label) {
+        auto copy = grid;
+        ASSERT_EQ(flood_fill(copy, single.regions[label].first_cell, 'o'), single.regions[label].size);
+    }
+}
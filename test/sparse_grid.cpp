@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "../src/solutions/sparse_grid.h"
+
+TEST(SparseGrid, access) {
+    SparseGrid grid;
+    ASSERT_EQ(grid.at({-1000, 5000}), '.');
+    ASSERT_EQ(grid.tile_count(), 0);
+
+    // Background writes do not allocate
+    grid.set({3, 3}, '.');
+    ASSERT_EQ(grid.tile_count(), 0);
+
+    grid.set({0, 0}, '#');
+    grid.set({-1, -1}, 'o');
+    grid.set({63, 63}, '#');
+    grid.set({64, 0}, '#');
+    ASSERT_EQ(grid.tile_count(), 3);
+    ASSERT_EQ(grid.at({0, 0}), '#');
+    ASSERT_EQ(grid.at({-1, -1}), 'o');
+    ASSERT_EQ(grid.at({63, 63}), '#');
+    ASSERT_EQ(grid.at({64, 0}), '#');
+    ASSERT_EQ(grid.at({-1, 0}), '.');
+    ASSERT_EQ(grid.count('#'), 3);
+
+    std::size_t cells = 0;
+    grid.for_each_cell([&cells](const GridCell&, char) { cells++; });
+    ASSERT_EQ(cells, 4);
+
+    auto bounds = grid.bounds();
+    ASSERT_TRUE(bounds.has_value());
+    ASSERT_EQ(bounds->first, (GridCell{-1, -1}));
+    ASSERT_EQ(bounds->second, (GridCell{64, 63}));
+}
+
+TEST(SparseGrid, to_grid) {
+    SparseGrid grid(' ');
+    ASSERT_THROW(grid.to_grid(), std::logic_error);
+
+    grid.set({-2, 10}, 'a');
+    grid.set({0, 12}, 'b');
+    auto dense = grid.to_grid();
+
+    ASSERT_EQ(dense.rows, 3);
+    ASSERT_EQ(dense.columns, 3);
+    ASSERT_EQ(dense.packed_data(), "a  " "   " "  b");
+    ASSERT_EQ(dense.at(GridCell{0, 12} + dense.origin), 'b');
+}
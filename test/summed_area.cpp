@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../src/solutions/summed_area.h"
+
+TEST(SummedAreaTable, queries) {
+    auto grid = make_grid(
+            "#..#\n"
+            ".##.\n"
+            "#...\n"
+    );
+    auto table = make_summed_area_table(grid, '#');
+
+    ASSERT_EQ(table.total(), 5);
+    ASSERT_EQ(table.rectangle({0, 0}, {2, 3}), 5);
+    ASSERT_EQ(table.rectangle({1, 1}, {1, 2}), 2);
+    ASSERT_EQ(table.rectangle({2, 3}, {0, 0}), 5);
+    ASSERT_EQ(table.rectangle({-5, -5}, {0, 10}), 2);
+    ASSERT_EQ(table.rectangle({5, 5}, {6, 6}), 0);
+
+    ASSERT_EQ(table.row_span(0, 0, 3), 2);
+    ASSERT_EQ(table.row_span(2, 1, 3), 0);
+    ASSERT_EQ(table.column_span(0, 0, 2), 2);
+    ASSERT_EQ(table.column_span(3, 1, 2), 0);
+
+    auto dots = make_summed_area_table(grid, [](char c) {
+        return c == '.';
+    });
+    ASSERT_EQ(dots.total(), 7);
+}
+
+TEST(SummedAreaTable, matches_brute_force) {
+    std::mt19937 random(34);
+    BitGrid bits(37, 90);
+    for (int i = 0; i < 1000; ++i) {
+        bits.flip({(long)(random() % 37), (long)(random() % 90)});
+    }
+    auto table = make_summed_area_table(bits);
+    auto from_grid = make_summed_area_table(make_grid(bits), '#');
+
+    for (int i = 0; i < 500; ++i) {
+        GridCell from{(long)(random() % 37), (long)(random() % 90)};
+        GridCell to{(long)(random() % 37), (long)(random() % 90)};
+
+        long expected = 0;
+        for (long row = std::min(from.row, to.row); row <= std::max(from.row, to.row); ++row) {
+            for (long column = std::min(from.column, to.column); column <= std::max(from.column, to.column); ++column) {
+                expected += bits.test({row, column});
+            }
+        }
+        ASSERT_EQ(table.rectangle(from, to), expected);
+        ASSERT_EQ(from_grid.rectangle(from, to), expected);
+    }
+    ASSERT_EQ(table.total(), (long)bits.popcount());
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include "../src/solutions/tilt.h"
+
+TEST(tilt, directions) {
+    const std::string rocks =
+            "O.#.\n"
+            "..O.\n"
+            "O#.O\n"
+            ".O..\n";
+
+    auto north = make_grid(rocks);
+    ASSERT_EQ(tilt(north, NEIGHBOURS_4[0]), 2);
+    ASSERT_EQ(north.packed_data(),
+              "O.#O"
+              "O.O."
+              ".#.."
+              ".O..");
+
+    auto east = make_grid(rocks);
+    tilt(east, NEIGHBOURS_4[1]);
+    ASSERT_EQ(east.packed_data(),
+              ".O#."
+              "...O"
+              "O#.O"
+              "...O");
+
+    auto south = make_grid(rocks);
+    tilt(south, NEIGHBOURS_4[2]);
+    ASSERT_EQ(south.packed_data(),
+              "..#."
+              "...."
+              "O#.."
+              "OOOO");
+
+    auto west = make_grid(rocks);
+    tilt(west, NEIGHBOURS_4[3]);
+    ASSERT_EQ(west.packed_data(),
+              "O.#."
+              "O..."
+              "O#O."
+              "O...");
+
+    // Already settled grids do not move
+    ASSERT_EQ(tilt(west, NEIGHBOURS_4[3]), 0);
+    ASSERT_THROW(tilt(west, GridCell{1, 1}), std::logic_error);
+}
+
+TEST(tilt, keeps_hash) {
+    auto grid = make_grid(
+            "O..O#.\n"
+            ".O#..O\n"
+            "..O...\n"
+    );
+    grid.enable_hashing();
+    for (const auto& direction: NEIGHBOURS_4) {
+        tilt(grid, direction);
+        ASSERT_EQ(grid.state_hash(), Grid(grid.rows, grid.columns, grid.packed_data()).state_hash());
+    }
+}